@@ -5,6 +5,9 @@
 #include <string>
 #include<cassert>
 #include<optional>
+#include <array>
+#include <memory_resource> //std::pmr::string in MonsterStats
+#include "EnumMeta.h"
 
 #if 0
 //11.1 Intro to function overloading
@@ -533,6 +536,7 @@ enum MonsterType
 };
 #endif
 //13.2 Q2 Put MonsterType in a namespace
+//The quiz enums in this file are just the quizzes, the game's monster types come from MonsterCatalog now.
 namespace MonsterType
 {
 	enum MonsterType
@@ -557,6 +561,7 @@ namespace MonsterType
 //13.4 Converting an enumeration to and from a string
 //If enumerators implicitly cast to an integral value, how do we get the type of enumerator?
 //A common solution is to create a function which can return a string of the enumerator type.
+#if 0
 constexpr std::string_view getMonsterName(MonsterType::MonsterType monster)
 {
 	switch (monster)
@@ -569,9 +574,25 @@ constexpr std::string_view getMonsterName(MonsterType::MonsterType monster)
 	default: return "No Type";
 	}
 }
+#endif
+//Every enum in these notes ended up with its own switch like the one above. EnumMeta(EnumMeta.h) keeps the names in
+//one table per enum instead, and both directions come from that table: to string is an array index,
+//from string is a perfect hash lookup. The names have to be in the same order as the enumerators.
+template <>
+struct EnumMeta::Traits<MonsterType::MonsterType>
+{
+	static constexpr std::array<std::string_view, 5> names{ "orc", "goblin", "troll", "ogre", "skeleton" };
+	static constexpr std::string_view invalid{ "No Type" };
+};
+
+constexpr std::string_view getMonsterName(MonsterType::MonsterType monster)
+{
+	return EnumMeta::toString(monster);
+}
 //This does let us access the name, put isn't as convenient as typing std::cout << troll;
 //With information we have learned this is as good as we can get. There is a solutin covered when we talk about arrays.
 //Taking enumeration like this can also be useful for user input.
+#if 0
 constexpr std::optional<MonsterType::MonsterType> getMonsterType(std::string_view sv)
 {
 	if (sv == "orc") return MonsterType::orc;
@@ -582,6 +603,15 @@ constexpr std::optional<MonsterType::MonsterType> getMonsterType(std::string_vie
 
 	return{};
 }
+#endif
+//The version above compares against every name until one matches. EnumMeta::fromString uses a PerfectHash::Table(PerfectHash.h)
+//that hashes the input straight to the only name it could be, so there is just one compare no matter how many monsters there are.
+constexpr std::optional<MonsterType::MonsterType> getMonsterType(std::string_view sv)
+{
+	return EnumMeta::fromString<MonsterType::MonsterType>(sv);
+}
+static_assert(getMonsterType("troll") == MonsterType::troll);
+static_assert(!getMonsterType("dragon"));
 
 //13.5 Introduction to overloading the I/O operators
 //In C++, similar to function overloading we can also do operator overloading.
@@ -641,18 +671,16 @@ enum class Animal
 	duck,
 };
 
+template <>
+struct EnumMeta::Traits<Animal>
+{
+	static constexpr std::array<std::string_view, 6> names{ "pig", "chicken", "goat", "cat", "dog", "duck" };
+	static constexpr std::string_view invalid{ "You did not enter a valid animal." };
+};
+
 constexpr std::string_view getAnimalName(Animal animal)
 {
-	switch (animal)
-	{
-	case Animal::pig: return "pig";
-	case Animal::chicken: return "chicken";
-	case Animal::goat: return "goat";
-	case Animal::cat: return "cat";
-	case Animal::dog: return "dog";
-	case Animal::duck: return "duck";
-	default: return "You did not enter a valid animal.";
-	}
+	return EnumMeta::toString(animal);
 }
 
 void printNumberOfLegs(Animal animal)
@@ -859,6 +887,7 @@ void print(const Coord<T>& c) {
 	std::cout << c.a << ' ' << c.b << '\n';
 }
 //13.x Q1 Functions:
+//Only the quiz, like MonsterType above. The game's monsters(Monster.h) get their types from MonsterCatalog.
 enum class Monster {
 	ogre,
 	dragon,
@@ -867,21 +896,23 @@ enum class Monster {
 	slime,
 };
 
-std::string_view monsterToString(Monster monster) {
-	switch (monster)
-	{
-	case Monster::ogre: return "Ogre";
-	case Monster::dragon: return "Dragon";
-	case Monster::orc: return "Orc";
-	case Monster::spider: return "Giant Spider";
-	case Monster::slime: return "Slime";
-	default: return "INVALID";
-	}
+template <>
+struct EnumMeta::Traits<Monster>
+{
+	static constexpr std::array<std::string_view, 5> names{ "Ogre", "Dragon", "Orc", "Giant Spider", "Slime" };
+	static constexpr std::string_view invalid{ "INVALID" };
+};
+
+constexpr std::string_view monsterToString(Monster monster) {
+	return EnumMeta::toString(monster);
 }
 
+//name is a std::pmr::string so a whole encounter's worth of monsters can allocate from one FrameArena(see FrameArena.h):
+//MonsterStats orc{ Monster::orc, std::pmr::string{ "Grug the Unwashed", &arena }, 40 };
+//Plain string literals still work like before and use the global heap.
 struct MonsterStats {
 	Monster monsterType{};
-	std::string name{};
+	std::pmr::string name{};
 	int health{};
 };
 
@@ -9,10 +9,31 @@
 #include <string>
 #include <string_view>
 
+#include "CommandReader.h"
 #include "Date.h"
 #include "Point3d.h"
 #include "Vector3d.h"
 #include "Random.h"
+#include "Monster.h"
+#include "Potion.h"
+#include "Player.h"
+#include "FrameArena.h"
+#include "Hilo.h"
+#include "InventoryAnalytics.h"
+#include "Items.h"
+#include "EnumMeta.h"
+#include "Expression.h"
+#include "PerfectHash.h"
+#include "PlayerIndex.h"
+#include "PlayerStore.h"
+#include "MonsterCatalog.h"
+#include "MonsterStore.h"
+#include "PackedInventory.h"
+#include "PriceTable.h"
+#include "Shop.h"
+#include "Snapshot.h"
+#include "Benchmarks.h"
+#include "Combat.h"
 
 
 //15.1 The hidden "this" pointer and member function chaining
@@ -374,84 +395,7 @@ void Point3d::moveByVector(const Vector3d& v)
 //Essentially, this is a way to function overload and the correct version will be called depending on the case.
 
 //15.x
-
-
-class Monster {
-public:
-	enum Type {
-		dragon,
-		goblin,
-		ogre,
-		orc,
-		skeleton,
-		troll,
-		vampire,
-		zombie,
-		maxMonsterTypes,
-	};
-
-private:
-	Type m_type{};
-	std::string m_name{"?"};
-	std::string m_roar{"?"};
-	int m_hp{0};
-
-public:
-	Monster(Type type, std::string name, std::string roar, int hp)
-		: m_type{type}, m_name{name}, m_roar{roar}, m_hp{hp}
-	{ }
-
-	constexpr std::string_view getTypeString() const {
-		switch (m_type) {
-		case dragon: return "dragon";
-		case goblin: return "goblin";
-		case ogre: return "ogre";
-		case orc: return "orc";
-		case skeleton: return "skeleton";
-		case troll: return "troll";
-		case vampire: return "vampire";
-		case zombie: return "zombie";
-		default: return "???";
-		}
-	}
-
-	void print() const {
-		if (m_hp <= 0) {
-			std::cout << m_name << " the " << getTypeString() << " is dead.\n";
-		}
-		else {
-			std::cout << m_name << " the " << getTypeString() << " has " << m_hp << " hit points and says " << m_roar << ".\n";
-		}
-	}
-
-};
-
-namespace MonsterGenerator {
-	std::string getName(int x) {
-		switch (x) {
-		case 0: return "Sheldon";
-		case 1: return "Thrall";
-		case 2: return "Temarri";
-		case 3: return "Mythgor";
-		case 4: return "Shawn";
-		default: return "Lameo";
-		}
-	}
-	std::string getRoar(int x) {
-		switch (x) {
-		case 0: return "*ROAR*";
-		case 1: return "*rawr*";
-		case 2: return "*shiver*";
-		case 3: return "*crunch*";
-		case 4: return "*growl*";
-		default: return "I'm scared, please leave me alone.";
-		}
-	}
-
-	Monster generate() {
-		return Monster{ Monster::skeleton, getName(Random::get(0,5)), getRoar(Random::get(0,5)), Random::get(0,100) };
-	}
-}
+//Monster and MonsterGenerator live in Monster.h/Monster.cpp.
 
 //16.1 Intro to containers and arrays
 //Talked about arrays tons in college, I assume most of Java and C# arrays will be similar to this...
@@ -556,32 +500,35 @@ void ignoreLine()
 	std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
-int getUserInt()
+//Same rules as before, but reading through a CommandReader instead of std::cin, so a script with millions of
+//commands doesn't go through std::cin >> and std::cin.ignore() for every one.
+//Returns std::nullopt once the input runs out(the std::cin version looped forever on end of input).
+std::optional<int> getUserInt(CommandReader& input)
 {
 	while (true)
 	{
-		int input;
-		std::cin >> input;
+		const CommandReader::IntInput guess{ input.readInt(0, 9) }; //readInt() does the ignoreLine() itself
 
-		if (!std::cin)
+		switch (guess.result)
 		{
-			std::cin.clear();
-			ignoreLine();
+		case CommandReader::IntResult::ok:
+			return guess.value;
+		case CommandReader::IntResult::invalid:
 			std::cout << "Please enter a valid guess: ";
 			continue;
-		}
-		if (input > 9 || input < 0) {
-			std::cin.clear();
-			ignoreLine();
+		case CommandReader::IntResult::outOfRange:
 			std::cout << "Please enter number between 1 and 9: ";
 			continue;
+		case CommandReader::IntResult::end:
+			return std::nullopt;
 		}
-
-		//If extraction succeeds:
-		ignoreLine();
-		return input;
 	}
 }
+
+int getUserInt()
+{
+	return getUserInt(CommandReader::standardInput()).value_or(-1);
+}
 template<typename T>
 void guessingGame(const std::vector<T>& arr) {
 	std::cout << "Enter a number between 1 and 9: ";
@@ -707,16 +654,15 @@ namespace Animals {
 	const std::vector legs{ 2, 4, 4, 4, 2, 0 };
 }
 
-std::string_view getAnimal(Animals::Types animal) {
-	switch (animal) {
-	case Animals::chicken: return "chicken";
-	case Animals::dog: return "dog";
-	case Animals::cat: return "cat";
-	case Animals::elephant: return "elephant";
-	case Animals::duck: return "duck";
-	case Animals::snake: return "snake";
-	default: return "???";
-	}
+//The names live in one table(EnumMeta.h) instead of a switch, so this is just an array index.
+template <>
+struct EnumMeta::Traits<Animals::Types> {
+	static constexpr std::array<std::string_view, 6> names{ "chicken", "dog", "cat", "elephant", "duck", "snake" };
+	static constexpr Animals::Types end{ Animals::max_types };
+};
+
+constexpr std::string_view getAnimal(Animals::Types animal) {
+	return EnumMeta::toString(animal);
 }
 
 //16.10 vector resizing and capacity
@@ -806,41 +752,15 @@ void pushPrint(std::vector<int>& stack, int val) {
 //This means that while it is a vector, it isn't compatible with the full functionality of the standard library.
 //As a result of these issues, we should avoid std::vector<bool>, if we wanna do bit manipulation don't use a vector.
 
-//16.x Q2
-namespace Items {
-	enum Types {
-		health_potion,
-		torch,
-		arrow,
-		max_value,
-	};
-}
-
-std::string_view getItemName(Items::Types type) {
-	switch (type) {
-	case Items::health_potion: return "health potion";
-	case Items::torch: return "torch";
-	case Items::arrow: return "arrow";
-	default: return "???";
-	}
+//16.x Q2 (Items namespace is in Items.h)
+constexpr std::string_view getItemName(Items::Types type) {
+	return EnumMeta::toString(type);
 }
 
+//Used to build a std::string for every item and compare it to "torch" to get the plural right.
+//Items.h has the plurals worked out ahead of time and writes whole lines into one buffer instead.
 void printSpecifics(const std::vector<int>& arr) {
-	std::size_t length{ arr.size() };
-
-	for (std::size_t i{ 0 }; i < length; ++i) {
-		std::string name{ getItemName(static_cast<Items::Types>(i)) };
-
-		std::cout << "You have " << arr[i] << ' ' << name;
-
-		if (arr[i] != 1) {
-			if (name == "torch")
-				std::cout << "es";
-			else
-				std::cout << 's';
-		}
-		std::cout << " in your inventory.\n";
-	}
+	Items::printSpecifics(arr);
 }
 
 int countInventory(const std::vector<int>& arr) {
@@ -851,6 +771,15 @@ int countInventory(const std::vector<int>& arr) {
 	return total;
 }
 
+//Packed version of the same inventory: each count gets only as many bits as it needs instead of a whole int(see PackedInventory.h).
+//Up to 15 health potions, 63 torches and 255 arrows, all in one 4 byte integer.
+using ItemInventory = PackedInventory<4, 6, 8>;
+static_assert(ItemInventory::itemCount == Items::max_value);
+
+int countInventory(const ItemInventory& inventory) {
+	return inventory.total();
+}
+
 //16.x Q3 --- Also used in Q4
 template<typename T>
 std::pair<int, int> returnPair(const std::vector<T>& arr) {
@@ -955,11 +884,18 @@ namespace Color {
 	using namespace std::string_view_literals;
 	constexpr std::array colorName{ "black"sv, "red"sv, "blue"sv };
 
-	static_assert(std::size(colorName) == max_colors);
 }
 
+//Registering colorName with EnumMeta checks its size against max_colors(instead of a static_assert here)
+//and gives us toString/fromString. fromString hashes the input to the one name it could be(see PerfectHash.h).
+template <>
+struct EnumMeta::Traits<Color::Type> {
+	static constexpr std::array names{ Color::colorName };
+	static constexpr Color::Type end{ Color::max_colors };
+};
+
 constexpr std::string_view getColorName(Color::Type color) {
-	return Color::colorName[static_cast<std::size_t>(color)]; //index the array using the enumerator.
+	return EnumMeta::toString(color); //indexes colorName using the enumerator.
 }
 /// <summary>
 /// Teaches the operator<< how to print a color using the getColorName function.
@@ -978,15 +914,11 @@ std::istream& operator>> (std::istream& in, Color::Type& color)
 	std::string input{};
 	std::getline(in >> std::ws, input);
 
-	// Iterate through the list of names to see if we can find a matching name
-	for (std::size_t index = 0; index < Color::colorName.size(); ++index)
+	// Look the name up in the perfect hash table, one hash and one string compare
+	if (std::optional<Color::Type> match{ EnumMeta::fromString<Color::Type>(input) })
 	{
-		if (input == Color::colorName[index])
-		{
-			// If we found a matching name, we can get the enumerator value based on its index
-			color = static_cast<Color::Type>(index);
-			return in;
-		}
+		color = *match;
+		return in;
 	}
 
 	// We didn't find a match, so input must have been invalid
@@ -1027,9 +959,15 @@ namespace Animal {
 							Data{"elephant"sv, 4, "pawoo"sv}, Data{"duck"sv, 2, "quack"sv}, Data{"snake"sv, 0, "hiss"sv}};
 
 	static_assert(std::size(types) == max_animals);
-	static_assert(std::size(data) == max_animals);
 }
 
+//EnumMeta checks data has max_animals entries.
+template <>
+struct EnumMeta::Traits<Animal::Type> {
+	static constexpr std::array names{ PerfectHash::names(Animal::data, &Animal::Data::name) };
+	static constexpr Animal::Type end{ Animal::max_animals };
+};
+
 // Teach operator>> how to input a Color by name
 // We pass color by non-const reference so we can have the function modify its value
 std::istream& operator>> (std::istream& in, Animal::Type& animal)
@@ -1037,15 +975,10 @@ std::istream& operator>> (std::istream& in, Animal::Type& animal)
 	std::string input{};
 	std::getline(in >> std::ws, input);
 
-	// Iterate through the list of names to see if we can find a matching name
-	for (std::size_t index = 0; index < Animal::data.size(); ++index)
+	if (std::optional<Animal::Type> match{ EnumMeta::fromString<Animal::Type>(input) })
 	{
-		if (input == Animal::data[index].name)
-		{
-			// If we found a matching name, we can get the enumerator value based on its index
-			animal = static_cast<Animal::Type>(index);
-			return in;
-		}
+		animal = *match;
+		return in;
 	}
 
 	// We didn't find a match, so input must have been invalid
@@ -1145,24 +1078,7 @@ void printArray(const Array2d<T, Row, Col>& arr)
 
 //17.x
 //Q2
-namespace Potion {
-	enum Type {
-		healing,
-		mana,
-		speed,
-		invisibility,
-		max_types,
-	};
-	constexpr std::array types{ healing, mana, speed, invisibility };
-
-	constexpr std::array<int, max_types> costs{ 20, 30, 12, 50 };
-	constexpr std::array<std::string_view, max_types> names{"healing", "mana", "speed", "invisibility"};
-	//Make sure the sizes of the arrays are accurate.
-	static_assert(std::size(types) == max_types);
-	static_assert(std::size(costs) == max_types);
-	static_assert(std::size(names) == max_types);
-}
-
+//Potion is in Potion.h, Player is in Player.h/Player.cpp.
 void shop() {
 	std::cout << '\n' << "Here is our selection for today: \n";
 	for (auto type : Potion::types) {
@@ -1171,31 +1087,16 @@ void shop() {
 	std::cout << '\n';
 }
 
-class Player {
-private:
-	std::string m_name{};
-	int m_gold{};
-	std::array<int, Potion::max_types> m_inventory{};
-public:
-	Player(std::string_view name) : m_name {name}, m_gold {Random::get(80, 120)}
-	{ }
-
-	int getGold() { return m_gold; }
-	int setGold(int cost) { return m_gold - cost; }
-	int inventory(Potion::Type index) const { return m_inventory[index]; }
-};
-
 int charNumToInt(char c)
 {
 	return c - '0';
 }
 
-void gameStart() {
+void gameStart(CommandReader& input) {
 	std::cout << "Welcome to Roscoe's potion emporium!\n";
 	std::cout << "Enter your name: ";
 
-	std::string name;
-	std::cin >> name;
+	const std::string name{ input.word().value_or("") };
 
 	Player player = Player(name);
 	std::cout << "Hello, " << name << " you have " << player.getGold() << " gold.\n";
@@ -1204,24 +1105,21 @@ void gameStart() {
 
 	std::cout << "Enter the number of the potion you'd like to buy, or 'q' to quit: ";
 	
-	while (true) {
-		char input;
-		std::cin >> input;
-		if (input == 'q') {
+	//Stops at 'q' or at the end of the input.
+	while (const std::optional<char> command{ input.character() }) {
+		if (*command == 'q') {
 			break;
 		}
-		if (!std::cin) {
-			std::cin.clear();
-			ignoreLine();
-			std::cout << "Please enter a valid guess: ";
-			continue;
-		}
 	}
 	
 
 	std::cout << "Thanks for shopping at Roscoe's potion emporium!\n";
 }
 
+void gameStart() {
+	gameStart(CommandReader::standardInput());
+}
+
 //18.1 Sorting an array using selection sort
 //Talked about this in college, could be very useful to review nonetheless.
 //Selection sort is probably the easiest sorting method to implement and understand.
@@ -1406,6 +1304,30 @@ int main() {
 	assert(inventory.size() == Items::max_value);
 	printSpecifics(inventory);
 	std::cout << "You have " << countInventory(inventory) << " total items\n";
+	Benchmarks::itemPrint(1'000'000);
+#endif
+#if 0
+	//16.x Q2 with a packed inventory. Counts stop at the slot's max instead of overflowing.
+	ItemInventory packed{};
+	packed.add(Items::health_potion, 1);
+	packed.add(Items::torch, 5);
+	packed.add(Items::arrow, 10);
+	packed.add(Items::health_potion, 100); //only goes up to 15
+	std::cout << "You have " << countInventory(packed) << " total items in " << sizeof(packed) << " bytes\n";
+	Benchmarks::inventories(10'000'000);
+#endif
+#if 0
+	//16.x Q2 for lots of players at once: one column of counts per item instead of one inventory per player.
+	ItemInventory bag{};
+	bag.add(Items::torch, 3);
+	bag.add(Items::arrow, 20);
+	InventoryColumns everyone{ Items::max_value };
+	everyone.addPlayer(bag);
+	everyone.addPlayer(std::vector{ 2, 0, 30 });
+	everyone.addPlayer(std::vector{ 0, 12, 7 });
+	std::cout << "All players have " << InventoryAnalytics::total(everyone) << " total items, most arrows: player "
+		<< InventoryAnalytics::topK(everyone, Items::arrow, 1)[0] << '\n';
+	Benchmarks::inventoryAnalytics(10'000'000, Parallel::defaultThreadCount());
 #endif
 
 #if 0
@@ -1598,6 +1520,153 @@ int main() {
 	Monster m{ MonsterGenerator::generate() };
 	m.print();
 #endif
+#if 0
+	//15.x printing a lot of monsters at once: printMonsters() builds all the lines in one buffer and writes it once.
+	std::vector<Monster> horde{};
+	for (int i = 0; i < 5; ++i) {
+		horde.push_back(MonsterGenerator::generate());
+	}
+	printMonsters(horde);
+	Benchmarks::monsterPrint(1'000'000);
+#endif
+#if 0
+	//15.x with lots of monsters. MonsterStore keeps each field in its own array.
+	MonsterStore store{};
+	for (int i = 0; i < 10; ++i) {
+		store.add(MonsterGenerator::generate());
+	}
+	store.damageAll(50);
+	const Monster::Type skeleton{ MonsterCatalog::global().find("skeleton").value_or(0) };
+	std::cout << store.aliveCount() << " monsters survived, " << store.filterByType(skeleton).size() << " are skeletons.\n";
+	store.toMonster(0).print();
+
+	Benchmarks::monsterStore(100'000, 1000);
+#endif
+#if 0
+	//15.x names and roars are interned: every monster named "Thrall" points at the same string.
+	Monster a{ MonsterGenerator::generate() };
+	Monster b{ MonsterCatalog::global().find("orc").value_or(0), "Thrall", "*rawr*", 10 };
+	std::cout << (b.getNameHandle() == MonsterGenerator::getName(b.getType(), 1)) << '\n'; //prints 1 with the built in types
+	a.print();
+	Benchmarks::monsterAllocations(1'000'000);
+#endif
+#if 0
+	//15.x a whole wave of monsters at once. Same seed, same wave.
+	MonsterStore wave{ MonsterGenerator::generateBatch(1'000'000, 1234) };
+	std::cout << wave.aliveCount() << " of " << wave.size() << " monsters are alive.\n";
+	wave.toMonster(0).print();
+	Benchmarks::monsterBatch(1'000'000, 64);
+#endif
+#if 0
+	//15.x monster types come from a file(monsters.txt) instead of an enum, no rebuild needed to add one.
+	//Without the file it's the built in 15.x types, saved here as monsters.txt to have something to edit.
+	if (!MonsterCatalog::loadText("monsters.txt"))
+		MonsterCatalog::builtIn().saveText("monsters.txt");
+	const MonsterCatalog& catalog{ MonsterCatalog::global() };
+	for (MonsterCatalog::TypeId id = 0; id < catalog.size(); ++id) {
+		std::cout << catalog.name(id) << " starts with " << catalog.baseHp(id) << " hp and says "
+			<< (catalog.roarCount(id) > 0 ? catalog.roar(id, 0) : "nothing") << ".\n";
+	}
+	Benchmarks::monsterCatalog(100'000);
+#endif
+#if 0
+	//15.x/17.x simulated fights between a party of players and a pack of monsters. Same seed, same fights.
+	Combat::Config config{};
+	std::vector<Combat::Result> results{ Combat::runMany(config, 10'000, 42) };
+	std::cout << "Encounter 0 took " << results[0].ticks << " ticks, " << (results[0].playersWon() ? "players" : "monsters") << " won.\n";
+
+	std::vector<Combat::Event> log{};
+	Combat::replay(config, 42, 0, log);
+	for (const Combat::Event& event : log) {
+		if (event.kind == Combat::Event::death)
+			std::cout << "tick " << event.tick << ": " << (event.targetSide == Combat::Side::players ? "player " : "monster ") << event.target << " died\n";
+	}
+	Benchmarks::combat(100'000, 64);
+#endif
+#if 0
+	//17.x what-if: fork the player's gold/potions and the monsters, try something on the fork, the original doesn't change.
+	Player tester{ "Tester" };
+	std::vector<Monster> pack{};
+	for (int i = 0; i < 1000; ++i) {
+		pack.push_back(MonsterGenerator::generate());
+	}
+	GameState now{ GameState::capture(tester, pack) };
+	GameState whatIf{ now.fork() }; //O(1), shares every monster with now
+	whatIf.player.gold -= Potion::costs[Potion::healing];
+	whatIf.monsters.mutate(0).takeDamage(1000); //copies only the chunk monster 0 is in
+	std::cout << now.monsters[0].isAlive() << ' ' << whatIf.monsters[0].isAlive() << '\n';
+	Benchmarks::snapshots(100'000, 10'000, 64);
+#endif
+#if 0
+	//17.x Q2 the shop for lots of players at once. Buying takes the gold and adds the potion in one step,
+	//so it is safe to call from many threads.
+	Shop emporium{ 1000, 100 };
+	Shop::Outcome outcome{ emporium.buy(7, Potion::invisibility) }; //costs 50, player 7 has 100
+	std::cout << (outcome == Shop::Outcome::bought) << ' ' << emporium.state(7).gold << '\n'; //1 50
+
+	Player roscoe{ "Roscoe" };
+	roscoe.buy(Potion::mana);
+	std::cout << roscoe.getGold() << ' ' << roscoe.inventory(Potion::mana) << '\n';
+	Benchmarks::shop(10'000, 10'000'000, 64);
+#endif
+#if 0
+	//17.x Q2 with prices that change while the shop is open.
+	//Readers never lock, changing a price is one atomic write.
+	Shop emporium{ 1000, 100 };
+	emporium.prices().set(Potion::invisibility, 25);
+	std::cout << emporium.prices().price(Potion::invisibility) << '\n'; //25
+	emporium.buy(7, Potion::invisibility);
+	std::cout << emporium.state(7).gold << '\n'; //75
+	Benchmarks::priceTable(10'000'000, 64);
+#endif
+#if 0
+	//17.x players that are still there after a restart. Changes go to a log file first, sync() waits for them to be on disk.
+	{
+		std::unique_ptr<PlayerStore> store{ PlayerStore::open("players") };
+		Player hero{ "Roscoe" };
+		const PlayerStore::PlayerId id{ store->add(hero) };
+		hero.buy(Potion::speed);
+		store->sync(store->update(id, hero));
+	}
+	std::unique_ptr<PlayerStore> reopened{ PlayerStore::open("players") };
+	std::cout << reopened->load(0).getName() << " has " << reopened->load(0).inventory(Potion::speed) << " speed potion\n";
+	Benchmarks::playerStore(1'000'000, 1'000, 64);
+#endif
+#if 0
+	//17.x finding a player by name without going through every player.
+	std::vector<Player> party{ Player{ "Alex" }, Player{ "Sam" }, Player{ "Roscoe" } };
+	PlayerIndex byName{};
+	for (std::size_t i{ 0 }; i < party.size(); ++i)
+		byName.insert(party[i].getName(), static_cast<std::uint32_t>(i));
+	if (const std::optional<std::uint32_t> slot{ byName.find("Roscoe") })
+		std::cout << "Roscoe has " << party[*slot].getGold() << " gold\n";
+	Benchmarks::playerIndex(1'000'000, 10'000'000);
+#endif
+#if 0
+	//gameStart() and getUserInt() driven from a script file instead of the keyboard.
+	if (std::unique_ptr<CommandReader> script{ CommandReader::open("potions.txt") }) {
+		gameStart(*script);
+	}
+	Benchmarks::commandReader(10'000'000);
+#endif
+#if 0
+	//8.x Q3 hilo() played by a strategy instead of a person, a million games at a time.
+	const Hilo::Report report{ Hilo::runMany(Hilo::Config{ 1, 100, 7 }, Hilo::Biased{ 0.25 }, 1'000'000, 42) };
+	std::cout << "won " << 100.0 * report.winRate() << "% in " << report.averageGuesses() << " guesses on average\n";
+	Benchmarks::hilo(10'000'000, 64);
+#endif
+#if 0
+	//17.x players and everything else made for one encounter can come from a FrameArena, which is freed all at once.
+	FrameArena arena{};
+	{
+		std::pmr::vector<Player> party{ &arena };
+		party.emplace_back("Alex");
+		party.emplace_back("Sam");
+		std::cout << party[1].getName() << " has " << party[1].getGold() << " gold.\n";
+	} //party has to be gone before the reset
+	arena.reset();
+	Benchmarks::encounters(100'000, 4, 64);
+#endif
 #if 0
 	//15.9 Q1/2/3
 	Point3d p{ 1.0, 2.0, 3.0 };
@@ -1667,11 +1736,38 @@ int main() {
 		std::cout << "I am not an apple";
 #endif
 
+#if 0
+	//17.6 operator>> finds the enumerator with a perfect hash instead of looping over the names.
+	std::cout << "Enter an animal: ";
+	Animal::Type animal{};
+	if (std::cin >> animal)
+		printAnimal(animal);
+	static_assert(EnumMeta::fromString<Color::Type>("blue") == Color::blue);
+	Benchmarks::enumParsing(10'000'000);
+#endif
+#if 0
+	//17.6 every enum's names come from EnumMeta, which also gives us a way to loop over the enumerators.
+	for (auto color : EnumMeta::values<Color::Type>())
+		std::cout << color << ' ';
+	std::cout << '\n' << getItemName(Items::torch) << ' ' << getAnimal(Animals::snake) << '\n';
+	Benchmarks::enumLookup(10'000'000);
+#endif
 #if 0
 	//15.2
 	Date date{ 2020, 5, 6 };
 	date.print();
 #endif
+#if 0
+	//15.1 Calc's chain of ops, but worked out for a whole column of numbers at once.
+	std::vector<int> values{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	std::vector<int> results(values.size());
+	const std::span<const int> column{ values };
+	if (const std::optional<Expression> chain{ Expression::compile("a + 5 - 3 * 4") }) {
+		chain->evaluate({ &column, 1 }, results);
+		std::cout << results[0] << ' ' << results[9] << '\n'; //12 48
+	}
+	Benchmarks::expressions(10'000'000, 64);
+#endif
 #if 0
 	//15.1
 	Calc calc{};
@@ -7,12 +7,20 @@
 #include "GlobalConsts.h"
 #include "Constants.h"
 #include "Random.h"
+#include "ShardedCounter.h"
+#include "Benchmarks.h"
+#include "Primes.h"
+#include "Sums.h"
+#include "FizzBuzz.h"
+#include "CommandReader.h"
 #include <cassert>;
 #include <cmath>
 #include <limits>
+#include <optional>
 #include <typeinfo>
 #include <string>
 #include <string_view>
+#include <thread>
 
 #if 0
 #if 0
@@ -99,6 +107,7 @@ int accumulate(int x)
 
 #if 0
 //Function created for 8.6 quiz question
+//Expression(Expression.h) runs a chain of these over columns of numbers without the switch for every op.
 int calculate(int x, int y, char op)
 {
     switch (op)
@@ -122,63 +131,27 @@ int calculate(int x, int y, char op)
 #endif
 
 //Used for 8.10 Q2
-int sumTo(int x)
+//The original loop added 1..x into an int, which overflowed for x above ~65535 and took x steps.
+//1 + 2 + ... + x = x(x + 1) / 2, so Sums::sumRange does it in one step with a long long result.
+//That always fits for an int x, so there's no need to check the optional.
+long long sumTo(int x)
 {
-    int sum = 0;
-    for (int i = 1; i <= x; ++i)
-    {
-        sum += i;
-    }
-    return sum;
+    return *Sums::sumRange(1, x);
 }
 
 //Used for 8.10 Q4
+//Originally this did up to three % per number and wrote every line with std::cout <<.
+//FizzBuzz::Engine (FizzBuzz.h) works out the repeating fizz/buzz pattern once and writes the lines in big chunks.
 void fizzbuzz(int x)
 {
-    for (int i = 1; i <= x; ++i)
-    {
-        if (i % 5 == 0 && i % 3 == 0)
-        {
-            std::cout << "fizzbuzz\n";
-        }
-        else if (i % 3 == 0) 
-        {
-            std::cout << "fizz\n";
-        }
-        else if (i % 5 == 0)
-        {
-            std::cout << "buzz\n";
-        }
-        else
-        {
-            std::cout << i << '\n';
-        }
-    }
+    OutputBuffer out{};
+    FizzBuzz::Engine{ FizzBuzz::fizzbuzzRules() }.run(1, x, out);
 }
 //Used for 8.10 Q5
 void fizzbuzzpop(int x)
 {
-    for (int i = 1; i <= x; ++i)
-    {
-        
-        if (i % 3 == 0)
-        {
-            std::cout << "fizz";
-        }
-        if (i % 5 == 0)
-        {
-            std::cout << "buzz";
-        }
-        if (i % 7 == 0)
-        {
-            std::cout << "pop";
-        }
-        if(i % 3 != 0 && i % 5 != 0 && i % 7 != 0)
-        {
-            std::cout << i;
-        }
-        std::cout << '\n';
-    }
+    OutputBuffer out{};
+    FizzBuzz::Engine{ FizzBuzz::fizzbuzzpopRules() }.run(1, x, out);
 }
 
 //8.x QUIZ FUNCTIONS:
@@ -218,6 +191,8 @@ double calculateAndPrintBallHeight(double towerHeight, int seconds)
 }
 
 //8.x Q2 Functions:
+//Trial division is fine for one number, but gets slow when checking millions of them.
+//Primes::Sieve (Primes.h) precomputes every prime up to a bound, so each check is just a bit lookup.
 bool isPrime(int x) 
 {
     if (x <= 1)
@@ -271,9 +246,8 @@ void hilo(int low, int high, int guesses)
             }
         }
     NewPlay:
-        char charInput;
         std::cout << "Would you like to play again (y/n)? ";
-        std::cin >> charInput;
+        char charInput = CommandReader::standardInput().character().value_or('n'); //same reader as getUserInt()
         if (charInput == 'n')
             break;
         else if(charInput != 'n' && charInput != 'y')
@@ -293,32 +267,30 @@ void ignoreLine()
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
-int getUserInt(int low, int high)
+//Reads through CommandReader(see CommandReader.h) instead of std::cin, same rules and messages.
+//Returns std::nullopt when the input runs out, the std::cin version looped forever there.
+std::optional<int> getUserInt(int low, int high, CommandReader& input = CommandReader::standardInput())
 {
     while (true)
     {
-        int input;
-        std::cin >> input;
+        const CommandReader::IntInput guess{ input.readInt(low, high) }; //skips the rest of the line itself
 
-        if (!std::cin)
+        if (guess.result == CommandReader::IntResult::end)
+            return std::nullopt;
+
+        if (guess.result == CommandReader::IntResult::invalid)
         {
-            std::cin.clear();
-            ignoreLine();
             std::cout << "Please enter a valid guess: ";
             continue;
         }
 
-        if (input < low || input > high)
+        if (guess.result == CommandReader::IntResult::outOfRange)
         {
-            std::cin.clear();
-            ignoreLine();
             std::cout << "Please guess again with a number that is in bounds: ";
             continue;
         }
 
-        //If extraction succeeds:
-        ignoreLine();
-        return input;
+        return guess.value;
     }
 }
 
@@ -331,7 +303,10 @@ void hilo(int low, int high, int guesses)
         for (int i = 1; i <= guesses; ++i)
         {
             std::cout << "Guess #" << i << ": ";
-            int input = getUserInt(low, high);
+            const std::optional<int> guess{ getUserInt(low, high) };
+            if (!guess)
+                return; //out of input
+            int input = *guess;
             if (input < x)
             {
                 std::cout << "Your guess is too low.\n";
@@ -349,9 +324,8 @@ void hilo(int low, int high, int guesses)
             }
         }
     NewPlay:
-        char charInput;
         std::cout << "Would you like to play again (y/n)? ";
-        std::cin >> charInput;
+        char charInput = CommandReader::standardInput().character().value_or('n'); //same reader as getUserInt()
         if (charInput == 'n')
             break;
         else if (charInput != 'n' && charInput != 'y')
@@ -365,18 +339,16 @@ void hilo(int low, int high, int guesses)
 
 void hiloStart()
 {
-    int low;
-    int high;
-    int guesses;
+    //Any int is allowed here, readInt() skips the rest of each line like ignoreLine() did.
+    constexpr int anyLow{ std::numeric_limits<int>::min() };
+    constexpr int anyHigh{ std::numeric_limits<int>::max() };
+    CommandReader& input{ CommandReader::standardInput() };
     std::cout << "Pick a lower bound for a guessing game: ";
-    std::cin >> low;
-    ignoreLine();
+    int low = input.readInt(anyLow, anyHigh).value;
     std::cout << "Pick a higher bound for a guessing game:  ";
-    std::cin >> high;
-    ignoreLine();
+    int high = input.readInt(anyLow, anyHigh).value;
     std::cout << "Pick the number of guesses you get:  ";
-    std::cin >> guesses;
-    ignoreLine();
+    int guesses = input.readInt(anyLow, anyHigh).value;
     hilo(low, high, guesses);
 }
 
@@ -499,6 +471,28 @@ int main()
     std::cout << "Success!\n";
 #endif
 
+#if 0
+    //8.x Q2 with a sieve. Numbers above the sieve's limit fall back to Miller-Rabin.
+    const Primes::Sieve sieve{ 1'000'000 };
+    assert(!sieve.isPrime(1));
+    assert(sieve.isPrime(2));
+    assert(sieve.isPrime(13417));
+    assert(!sieve.isPrime(999'999));
+    assert(sieve.isPrime(1'000'000'007)); //Above the limit
+    std::cout << "Success!\n";
+
+    Benchmarks::primes(10'000'000, 10'000'000);
+#endif
+
+#if 0
+    //Counting and listing primes in a range without keeping a sieve around.
+    std::cout << Primes::countPrimes(0, 100) << '\n'; // prints 25
+    Primes::forEachPrime(90, 110, [](std::uint64_t p) { std::cout << p << ' '; }); // prints 97 101 103 107 109
+    std::cout << '\n';
+
+    Benchmarks::primeCountScaling(10'000'000'000, 64);
+#endif
+
     //FOR LOOPS QUIZ STUFF:
 #if 0
     //8.10 Q1
@@ -513,6 +507,16 @@ int main()
     std::cout << sumTo(5);
 #endif
 
+#if 0
+    //8.10 Q2 for big ranges and sequences without a formula.
+    std::cout << sumTo(100'000) << '\n';                             // 5000050000, overflowed before
+    std::cout << *Sums::sumOfSquares(1, 10) << '\n';                 // 385
+    std::cout << *Sums::sumStrided(1, 2, 10) << '\n';                // 1 + 3 + ... + 19 = 100
+    std::cout << Sums::sumOfSquares(0, 4'000'000).has_value() << '\n'; // 0, about 2 * 10^19 is too big for a long long
+    std::cout << Sums::sumGenerated(10, [](long long i) { return i * i * i; }) << '\n'; // 2025
+    Benchmarks::sumSpanThroughput(256, 64);
+#endif
+
 #if 0
     //8.10 Q4
     fizzbuzz(15);
@@ -521,6 +525,13 @@ int main()
     //8.10 Q5
     fizzbuzzpop(150);
 #endif
+#if 0
+    //8.10 Q5 with made up rules, and a speed test. Try piping the output somewhere: CPPObjects.exe > out.txt
+    OutputBuffer out{};
+    FizzBuzz::Engine{ { { 2, "fizz" }, { 9, "buzz" }, { 11, "pop" } } }.run(1, 100, out);
+    out.flush();
+    Benchmarks::fizzbuzz(100'000'000);
+#endif
 
     //WHILE LOOPS QUIZ STUFF:
 #if 0
@@ -629,6 +640,20 @@ NotNegative:
     return 0;
 #endif
 
+#if 0
+    //7.x Q3 with threads: accumulate() isn't safe to call from more than one thread because of the static local.
+    //ShardedCounter gives each thread its own slot and adds the slots up when we ask for the total.
+    ShardedCounter<int> total{};
+    std::thread first{ [&] { for (int i = 0; i < 1000; ++i) total.add(4); } };
+    std::thread second{ [&] { for (int i = 0; i < 1000; ++i) total.add(3); } };
+    first.join();
+    second.join();
+    std::cout << total.get() << '\n'; // prints 7000
+
+    //Compares a single std::atomic<int> against ShardedCounter as the thread count goes up.
+    Benchmarks::counters(64, 1'000'000);
+#endif
+
 #if 0
     //INLINE AND UNNAMED NAMESPACE CODE:
     //Unnamed namespace allows this function to be called without qualifiers.
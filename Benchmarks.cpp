@@ -0,0 +1,1509 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "Combat.h"
+#include "CommandReader.h"
+#include "EnumMeta.h"
+#include "Expression.h"
+#include "FizzBuzz.h"
+#include "FrameArena.h"
+#include "Hilo.h"
+#include "InventoryAnalytics.h"
+#include "Items.h"
+#include "Monster.h"
+#include "MonsterCatalog.h"
+#include "MonsterStore.h"
+#include "OutputBuffer.h"
+#include "PackedInventory.h"
+#include "PerfectHash.h"
+#include "PlayerStore.h"
+#include "PriceTable.h"
+#include "Player.h"
+#include "PlayerIndex.h"
+#include "Primes.h"
+#include "Random.h"
+#include "ShardedCounter.h"
+#include "Shop.h"
+#include "Snapshot.h"
+#include "Sums.h"
+#include "Timer.h"
+
+//Counts every heap allocation in the program so the benchmarks can report them. This replaces the global
+//operator new for every file in the program, so it's off unless BENCHMARKS_COUNT_ALLOCATIONS is defined
+//(add it to the preprocessor definitions, or -DBENCHMARKS_COUNT_ALLOCATIONS).
+#ifdef BENCHMARKS_COUNT_ALLOCATIONS
+namespace
+{
+	std::atomic<unsigned long long> g_allocations{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory{ std::malloc(size == 0 ? 1 : size) })
+		return memory;
+	throw std::bad_alloc{};
+}
+
+//GCC warns about new + free when it inlines these into a caller in this file, even though the new is this one.
+//Not inlining them keeps the pairs matched as far as it can tell.
+#if defined(__GNUC__)
+[[gnu::noinline]]
+#endif
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+#if defined(__GNUC__)
+[[gnu::noinline]]
+#endif
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+#endif
+
+namespace
+{
+	unsigned long long allocationCount()
+	{
+#ifdef BENCHMARKS_COUNT_ALLOCATIONS
+		return g_allocations.load(std::memory_order_relaxed);
+#else
+		return 0;
+#endif
+	}
+
+	// Benchmarks that report allocations say so when counting is off, so the 0s aren't mistaken for real counts.
+	void noteAllocationCounting()
+	{
+#ifndef BENCHMARKS_COUNT_ALLOCATIONS
+		std::cout << "(allocation counts are 0, build with BENCHMARKS_COUNT_ALLOCATIONS defined to count them)\n";
+#endif
+	}
+
+	// Starts threadCount threads which each call work(), and returns how many seconds it took for all of them to finish.
+	template <typename Work>
+	double timeThreads(int threadCount, Work work)
+	{
+		std::vector<std::thread> threads{};
+		threads.reserve(threadCount);
+
+		Timer timer{};
+		for (int i{ 0 }; i < threadCount; ++i)
+			threads.emplace_back(work);
+		for (auto& thread : threads)
+			thread.join();
+		return timer.elapsed();
+	}
+
+	// Copy of isPrime() from 7.1-10.xnotes.cpp(8.x Q2), that file is #if 0'd out.
+	bool trialDivisionIsPrime(int x)
+	{
+		if (x <= 1)
+			return false;
+		if (x == 2)
+			return true;
+		if (x % 2 == 0)
+			return false;
+		for (int i = 3; i * i <= x; i += 2)
+		{
+			if (x % i == 0)
+				return false;
+		}
+		return true;
+	}
+
+	// The 15.x Monster and MonsterGenerator from before they used StringPool, to compare against.
+	namespace OldMonster
+	{
+		// The monster types were an enum before MonsterCatalog, in the same order as MonsterCatalog::builtIn().
+		enum Type
+		{
+			dragon,
+			goblin,
+			ogre,
+			orc,
+			skeleton,
+			troll,
+			vampire,
+			zombie,
+			maxMonsterTypes,
+		};
+
+		struct Monster
+		{
+			Type type{};
+			std::string name{};
+			std::string roar{};
+			int hp{};
+
+			Monster(Type t, std::string n, std::string r, int h)
+				: type{ t }, name{ n }, roar{ r }, hp{ h } // copied, not moved, like the original
+			{ }
+		};
+
+		std::string getName(int x)
+		{
+			switch (x)
+			{
+			case 0: return "Sheldon";
+			case 1: return "Thrall";
+			case 2: return "Temarri";
+			case 3: return "Mythgor";
+			case 4: return "Shawn";
+			default: return "Lameo";
+			}
+		}
+
+		std::string getRoar(int x)
+		{
+			switch (x)
+			{
+			case 0: return "*ROAR*";
+			case 1: return "*rawr*";
+			case 2: return "*shiver*";
+			case 3: return "*crunch*";
+			case 4: return "*growl*";
+			default: return "I'm scared, please leave me alone.";
+			}
+		}
+
+		Monster generate()
+		{
+			return Monster{ skeleton, getName(Random::get(0, 5)), getRoar(Random::get(0, 5)), Random::get(0, 100) };
+		}
+	}
+
+	// Like std::pmr::new_delete_resource(), but always goes through the plain operator new so the allocation
+	// counter above sees it(the library's version can call the aligned overload instead).
+	// Alignment isn't handled, nothing in the encounter needs more than operator new gives.
+	class GlobalHeapResource : public std::pmr::memory_resource
+	{
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t) override { return ::operator new(bytes); }
+		void do_deallocate(void* memory, std::size_t, std::size_t) override { ::operator delete(memory); }
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	// One encounter's worth of short lived objects. With the default resource everything goes to the global heap,
+	// with a FrameArena it all comes out of the arena. Names are long enough to not fit in the small string buffer.
+	// Returns something computed from the encounter so it can't be optimized away.
+	std::size_t runEncounter(int players, int monsters, std::pmr::memory_resource* resource)
+	{
+		struct NamedMonster // like MonsterStats from 13.x
+		{
+			Monster::Type type{};
+			std::pmr::string name{};
+			int health{};
+		};
+
+		std::pmr::vector<Player> party{ resource };
+		std::pmr::vector<NamedMonster> enemies{ resource };
+		std::pmr::vector<std::pmr::string> log{ resource };
+
+		for (int i{ 0 }; i < players; ++i)
+			party.emplace_back("Adventurer of the Northern Reaches");
+
+		const MonsterCatalog& catalog{ MonsterCatalog::global() };
+		for (int i{ 0 }; i < monsters; ++i)
+		{
+			const auto type{ static_cast<Monster::Type>(static_cast<std::size_t>(i) % catalog.size()) };
+			enemies.push_back(NamedMonster{ type, std::pmr::string{ MonsterGenerator::getName(type, i % 6).view(), resource }, 10 + i });
+			enemies.back().name += " of the Forgotten Crypt";
+		}
+
+		for (const NamedMonster& enemy : enemies)
+		{
+			std::pmr::string& line{ log.emplace_back() };
+			line += party[enemy.health % players].getName();
+			line += " hits the ";
+			line += enemy.name;
+		}
+
+		std::size_t total{ 0 };
+		for (const std::pmr::string& line : log)
+			total += line.size();
+		return total;
+	}
+
+	// Copy of the Animal::data names from 15.1-17.x.cpp(17.6 Q1), the enum lives in that file.
+	constexpr std::array<std::string_view, 6> animalNames{ "chicken", "dog", "cat", "elephant", "duck", "snake" };
+
+	// The loop operator>> used before PerfectHash.
+	std::optional<int> linearFind(std::string_view text)
+	{
+		for (std::size_t index{ 0 }; index < animalNames.size(); ++index)
+		{
+			if (text == animalNames[index])
+				return static_cast<int>(index);
+		}
+		return std::nullopt;
+	}
+
+	// Monster::getTypeString() from before EnumMeta and MonsterCatalog.
+	constexpr std::string_view switchTypeString(OldMonster::Type type)
+	{
+		switch (type)
+		{
+		case OldMonster::dragon: return "dragon";
+		case OldMonster::goblin: return "goblin";
+		case OldMonster::ogre: return "ogre";
+		case OldMonster::orc: return "orc";
+		case OldMonster::skeleton: return "skeleton";
+		case OldMonster::troll: return "troll";
+		case OldMonster::vampire: return "vampire";
+		case OldMonster::zombie: return "zombie";
+		default: return "???";
+		}
+	}
+
+	// Output that the OS throws away, so we time our code and not the disk.
+#ifdef _WIN32
+	constexpr const char* nullDevice{ "NUL" };
+#else
+	constexpr const char* nullDevice{ "/dev/null" };
+#endif
+
+	// Copy of calculate() from 7.1-10.xnotes.cpp(8.6 quiz).
+	int oldCalculate(int x, int y, char op)
+	{
+		switch (op)
+		{
+		case '+':
+			return x + y;
+		case '-':
+			return x - y;
+		case '*':
+			return x * y;
+		case '/':
+			return x / y;
+		case '%':
+			return x % y;
+		default:
+			std::cout << "Error: Invalid operator.\n";
+			return -1;
+		}
+	}
+
+	// Copy of the old printSpecifics() from 15.1-17.x.cpp(16.x Q2), before it used Items::printSpecifics().
+	void oldPrintSpecifics(const std::vector<int>& arr)
+	{
+		std::size_t length{ arr.size() };
+
+		for (std::size_t i{ 0 }; i < length; ++i) {
+			std::string name{ EnumMeta::toString(static_cast<Items::Types>(i)) };
+
+			std::cout << "You have " << arr[i] << ' ' << name;
+
+			if (arr[i] != 1) {
+				if (name == "torch")
+					std::cout << "es";
+				else
+					std::cout << 's';
+			}
+			std::cout << " in your inventory.\n";
+		}
+	}
+
+	// How many of each kind of answer a run of guesses got.
+	struct GuessCounts
+	{
+		long long valid{};
+		long long invalid{};
+		long long outOfRange{};
+		long long sum{};
+
+		friend bool operator==(const GuessCounts&, const GuessCounts&) = default;
+	};
+
+	// getUserInt() from 15.1-17.x.cpp(before CommandReader) without the prompts, reading until the stream runs out.
+	GuessCounts streamGuesses(std::istream& in)
+	{
+		GuessCounts counts{};
+		while (true)
+		{
+			int input;
+			in >> input;
+
+			if (!in)
+			{
+				if (in.eof())
+					return counts;
+				in.clear();
+				in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+				++counts.invalid;
+				continue;
+			}
+			if (input > 9 || input < 0) {
+				in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+				++counts.outOfRange;
+				continue;
+			}
+
+			in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+			++counts.valid;
+			counts.sum += input;
+		}
+	}
+
+	// Same thing through a CommandReader.
+	GuessCounts readerGuesses(CommandReader& reader)
+	{
+		GuessCounts counts{};
+		while (true)
+		{
+			const CommandReader::IntInput input{ reader.readInt(0, 9) };
+			switch (input.result)
+			{
+			case CommandReader::IntResult::ok:
+				++counts.valid;
+				counts.sum += input.value;
+				break;
+			case CommandReader::IntResult::invalid:
+				++counts.invalid;
+				break;
+			case CommandReader::IntResult::outOfRange:
+				++counts.outOfRange;
+				break;
+			case CommandReader::IntResult::end:
+				return counts;
+			}
+		}
+	}
+
+	// Millions of operations per second.
+	double mops(double operations, double seconds)
+	{
+		return operations / seconds / 1e6;
+	}
+
+	struct PriceReadResult
+	{
+		double seconds{};
+		long long torn{};		// reads that saw prices from two different versions
+		long long versions{};	// tables the writer published while the readers were going
+	};
+
+	// readerThreads threads each call read() readsPerThread times while one more thread keeps calling write(version)
+	// with a new version until they're done. read() returns the prices it saw, write(version) publishes a table where
+	// every price is version % 1000, so any table with two different prices in it is torn.
+	template <typename Read, typename Write>
+	PriceReadResult timePriceReads(int readerThreads, int readsPerThread, Read read, Write write)
+	{
+		std::atomic<bool> done{ false };
+		std::atomic<long long> torn{ 0 };
+		long long versions{ 0 };
+		std::thread writer{ [&] {
+			while (!done.load(std::memory_order_relaxed))
+				write(static_cast<int>(++versions % 1000));
+		} };
+
+		const double seconds{ timeThreads(readerThreads, [&] {
+			long long myTorn{ 0 };
+			for (int i{ 0 }; i < readsPerThread; ++i)
+			{
+				const PriceTable::Prices prices{ read() };
+				for (const int price : prices)
+					myTorn += price != prices[0];
+			}
+			torn.fetch_add(myTorn, std::memory_order_relaxed);
+		}) };
+
+		done.store(true, std::memory_order_relaxed);
+		writer.join();
+		return { seconds, torn.load(), versions };
+	}
+}
+
+namespace Benchmarks
+{
+	void counters(int maxThreads, int incrementsPerThread)
+	{
+		std::cout << "threads\tatomic<int> Mops/s\tShardedCounter Mops/s\n";
+
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			std::atomic<int> single{ 0 };
+			double singleTime{ timeThreads(threads, [&] {
+				for (int i{ 0 }; i < incrementsPerThread; ++i)
+					single.fetch_add(1, std::memory_order_relaxed);
+			}) };
+
+			ShardedCounter<long long> sharded{};
+			double shardedTime{ timeThreads(threads, [&] {
+				for (int i{ 0 }; i < incrementsPerThread; ++i)
+					sharded.increment();
+			}) };
+
+			const double total{ static_cast<double>(threads) * incrementsPerThread };
+			if (sharded.get() != static_cast<long long>(total) || single.load() != static_cast<int>(total))
+				std::cout << "Counts don't match!\n";
+
+			std::cout << threads << '\t' << mops(total, singleTime) << "\t\t\t" << mops(total, shardedTime) << '\n';
+		}
+	}
+
+	void primes(int queries, int maxValue)
+	{
+		// Same numbers for both versions. Fixed seed so runs can be compared.
+		std::mt19937 mt{ 12345 };
+		std::uniform_int_distribution values{ 0, maxValue };
+		std::vector<int> numbers(queries);
+		for (int& n : numbers)
+			n = values(mt);
+
+		Timer timer{};
+		int trialCount{ 0 };
+		for (const int n : numbers)
+			trialCount += trialDivisionIsPrime(n);
+		const double trialTime{ timer.elapsed() };
+
+		timer.reset();
+		const Primes::Sieve sieve{ static_cast<std::uint64_t>(maxValue) };
+		const double buildTime{ timer.elapsed() };
+
+		timer.reset();
+		int sieveCount{ 0 };
+		for (const int n : numbers)
+			sieveCount += sieve.isPrime(static_cast<std::uint64_t>(n));
+		const double sieveTime{ timer.elapsed() };
+
+		if (trialCount != sieveCount)
+			std::cout << "Prime counts don't match!\n";
+
+		std::cout << queries << " queries below " << maxValue << " (" << trialCount << " primes)\n";
+		std::cout << "Trial division:\t" << trialTime << "s\t" << mops(queries, trialTime) << " Mqueries/s\n";
+		std::cout << "Sieve:\t\t" << sieveTime << "s\t" << mops(queries, sieveTime) << " Mqueries/s (plus " << buildTime << "s to build)\n";
+	}
+
+	void primeCountScaling(unsigned long long limit, int maxThreads)
+	{
+		std::cout << "Counting primes below " << limit << '\n';
+		std::cout << "threads\tprimes\t\tseconds\tspeedup\n";
+
+		double oneThreadTime{};
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			Timer timer{};
+			const std::uint64_t count{ Primes::countPrimes(0, limit, threads) };
+			const double time{ timer.elapsed() };
+			if (threads == 1)
+				oneThreadTime = time;
+
+			std::cout << threads << '\t' << count << '\t' << time << '\t' << oneThreadTime / time << "x\n";
+		}
+	}
+
+	void sumSpanThroughput(int megabytes, int maxThreads)
+	{
+		const std::size_t count{ static_cast<std::size_t>(megabytes) * 1024 * 1024 / sizeof(int) };
+		std::vector<int> values(count);
+		for (std::size_t i{ 0 }; i < count; ++i)
+			values[i] = static_cast<int>(i % 1000);
+
+		const long long expected{ Sums::sumGenerated(static_cast<long long>(count), [](long long i) { return i % 1000; }) };
+		const double gigabytes{ static_cast<double>(count * sizeof(int)) / 1e9 };
+
+		std::cout << "Summing " << megabytes << "MB of ints\n";
+		std::cout << "threads\tGB/s\n";
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			// Best of 5, so the first pass paging the memory in doesn't count.
+			double best{ 0.0 };
+			for (int run{ 0 }; run < 5; ++run)
+			{
+				Timer timer{};
+				const long long total{ Sums::sumSpan(values, threads) };
+				const double time{ timer.elapsed() };
+				if (total != expected)
+					std::cout << "Sum doesn't match!\n";
+				best = std::max(best, gigabytes / time);
+			}
+			std::cout << threads << '\t' << best << '\n';
+		}
+	}
+
+	void fizzbuzz(long long lines)
+	{
+		// Same loop as fizzbuzzpop() in 7.1-10.xnotes.cpp, but to a file instead of std::cout.
+		std::ofstream stream{ nullDevice };
+		Timer timer{};
+		for (long long i{ 1 }; i <= lines; ++i)
+		{
+			if (i % 3 == 0)
+				stream << "fizz";
+			if (i % 5 == 0)
+				stream << "buzz";
+			if (i % 7 == 0)
+				stream << "pop";
+			if (i % 3 != 0 && i % 5 != 0 && i % 7 != 0)
+				stream << i;
+			stream << '\n';
+		}
+		stream.flush();
+		const double streamTime{ timer.elapsed() };
+
+		std::FILE* file{ std::fopen(nullDevice, "wb") };
+		unsigned long long bytes{};
+		timer.reset();
+		{
+			OutputBuffer out{ file };
+			FizzBuzz::Engine{ FizzBuzz::fizzbuzzpopRules() }.run(1, lines, out);
+			out.flush();
+			bytes = out.bytesWritten();
+		}
+		const double engineTime{ timer.elapsed() };
+		std::fclose(file);
+
+		std::cout << "fizzbuzzpop, " << lines << " lines (" << bytes / 1e9 << " GB)\n";
+		std::cout << "std::ostream <<:\t" << streamTime << "s\t" << mops(lines, streamTime) << " Mlines/s\t" << bytes / 1e9 / streamTime << " GB/s\n";
+		std::cout << "FizzBuzz::Engine:\t" << engineTime << "s\t" << mops(lines, engineTime) << " Mlines/s\t" << bytes / 1e9 / engineTime << " GB/s\n";
+	}
+
+	void monsterStore(int monsters, int ticks)
+	{
+		std::vector<Monster> vector{};
+		vector.reserve(monsters);
+		for (int i{ 0 }; i < monsters; ++i)
+			vector.push_back(MonsterGenerator::generate());
+
+		MonsterStore store{};
+		store.reserve(monsters);
+		for (const Monster& monster : vector)
+			store.add(monster);
+
+		// Monster only holds StringPool handles now, so there is nothing on the heap per monster.
+		const std::size_t vectorBytes{ vector.capacity() * sizeof(Monster) };
+
+		Timer timer{};
+		std::size_t vectorAlive{ 0 };
+		for (int tick{ 0 }; tick < ticks; ++tick)
+		{
+			vectorAlive = 0;
+			for (Monster& monster : vector)
+			{
+				monster.takeDamage(1);
+				vectorAlive += monster.isAlive();
+			}
+		}
+		const double vectorTime{ timer.elapsed() };
+
+		timer.reset();
+		std::size_t storeAlive{ 0 };
+		for (int tick{ 0 }; tick < ticks; ++tick)
+		{
+			store.damageAll(1);
+			storeAlive = store.aliveCount();
+		}
+		const double storeTime{ timer.elapsed() };
+
+		if (vectorAlive != storeAlive)
+			std::cout << "Alive counts don't match!\n";
+
+		std::cout << monsters << " monsters, " << ticks << " ticks\n";
+		std::cout << "std::vector<Monster>:\t" << static_cast<double>(vectorBytes) / monsters << " bytes/monster\t"
+			<< vectorTime / ticks * 1e6 << " us/tick\n";
+		std::cout << "MonsterStore:\t\t" << static_cast<double>(store.memoryUsage()) / monsters << " bytes/monster\t"
+			<< storeTime / ticks * 1e6 << " us/tick\n";
+	}
+
+	void monsterAllocations(int calls)
+	{
+#ifndef BENCHMARKS_COUNT_ALLOCATIONS
+		std::cout << "Allocation counting is off, build with BENCHMARKS_COUNT_ALLOCATIONS defined to count them\n";
+		return;
+#endif
+		// One call first so the pool's one time setup isn't counted.
+		MonsterGenerator::generate();
+
+		int alive{ 0 }; // use the results so the calls can't be optimized away
+		unsigned long long before{ allocationCount() };
+		Timer timer{};
+		for (int i{ 0 }; i < calls; ++i)
+			alive += OldMonster::generate().hp > 0;
+		const double oldTime{ timer.elapsed() };
+		const unsigned long long oldAllocations{ allocationCount() - before };
+
+		before = allocationCount();
+		timer.reset();
+		for (int i{ 0 }; i < calls; ++i)
+			alive += MonsterGenerator::generate().isAlive();
+		const double newTime{ timer.elapsed() };
+		const unsigned long long newAllocations{ allocationCount() - before };
+
+		std::cout << calls << " calls to generate() (" << alive << " alive)\n";
+		std::cout << "std::string names:\t" << oldAllocations << " allocations\t" << oldTime << "s\n";
+		std::cout << "StringPool handles:\t" << newAllocations << " allocations\t" << newTime << "s\n";
+	}
+
+	void monsterBatch(int monsters, int maxThreads)
+	{
+		std::vector<Monster> serial{};
+		Timer timer{};
+		serial.reserve(monsters);
+		for (int i{ 0 }; i < monsters; ++i)
+			serial.push_back(MonsterGenerator::generate());
+		const double serialTime{ timer.elapsed() };
+
+		std::cout << "Generating " << monsters << " monsters\n";
+		std::cout << "generate() loop:\t" << mops(monsters, serialTime) << " M monsters/s\n";
+		std::cout << "threads\tM monsters/s\tsame as 1 thread\n";
+
+		long long firstChecksum{ 0 };
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			timer.reset();
+			const MonsterStore store{ MonsterGenerator::generateBatch(monsters, 42, threads) };
+			const double time{ timer.elapsed() };
+
+			// The same seed should give the same monsters however many threads made them.
+			long long checksum{ 0 };
+			for (std::size_t i{ 0 }; i < store.size(); ++i)
+				checksum = checksum * 31 + store.hp(i) + store.name(i).size() * 7 + store.roar(i).size();
+			if (threads == 1)
+				firstChecksum = checksum;
+
+			std::cout << threads << '\t' << mops(monsters, time) << "\t\t" << (checksum == firstChecksum ? "yes" : "NO") << '\n';
+		}
+	}
+
+	void encounters(int count, int playersPerEncounter, int monstersPerEncounter)
+	{
+		noteAllocationCounting();
+
+		std::size_t checksum{ 0 };
+
+		GlobalHeapResource heap{};
+		unsigned long long before{ allocationCount() };
+		Timer timer{};
+		for (int i{ 0 }; i < count; ++i)
+			checksum += runEncounter(playersPerEncounter, monstersPerEncounter, &heap);
+		const double heapTime{ timer.elapsed() };
+		const unsigned long long heapAllocations{ allocationCount() - before };
+
+		FrameArena arena{};
+		before = allocationCount();
+		timer.reset();
+		for (int i{ 0 }; i < count; ++i)
+		{
+			checksum += runEncounter(playersPerEncounter, monstersPerEncounter, &arena);
+			arena.reset();
+		}
+		const double arenaTime{ timer.elapsed() };
+		const unsigned long long arenaAllocations{ allocationCount() - before };
+
+		std::cout << count << " encounters with " << playersPerEncounter << " players and " << monstersPerEncounter
+			<< " monsters (checksum " << checksum << ")\n";
+		std::cout << "global heap:\t" << heapTime / count * 1e6 << " us/encounter\t"
+			<< static_cast<double>(heapAllocations) / count << " allocations/encounter\n";
+		std::cout << "FrameArena:\t" << arenaTime / count * 1e6 << " us/encounter\t"
+			<< static_cast<double>(arenaAllocations) / count << " allocations/encounter\t"
+			<< arena.capacity() / 1024 << "KB kept\n";
+	}
+
+	void monsterPrint(int monsters)
+	{
+		std::vector<Monster> horde{};
+		horde.reserve(monsters);
+		for (int i{ 0 }; i < monsters; ++i)
+			horde.push_back(MonsterGenerator::generate());
+
+		// print() writes to std::cout, so point std::cout at the null device while it runs.
+		std::ofstream stream{ nullDevice };
+		std::streambuf* const coutBuffer{ std::cout.rdbuf(stream.rdbuf()) };
+		Timer timer{};
+		for (const Monster& monster : horde)
+			monster.print();
+		std::cout.flush();
+		const double printTime{ timer.elapsed() };
+		std::cout.rdbuf(coutBuffer);
+
+		std::FILE* file{ std::fopen(nullDevice, "wb") };
+		timer.reset();
+		printMonsters(horde, file);
+		const double bulkTime{ timer.elapsed() };
+		std::fclose(file);
+
+		std::cout << "Printing " << monsters << " monsters\n";
+		std::cout << "print() loop:\t" << printTime << "s\t" << mops(monsters, printTime) << " Mlines/s\n";
+		std::cout << "printMonsters():\t" << bulkTime << "s\t" << mops(monsters, bulkTime) << " Mlines/s\n";
+	}
+
+	void enumParsing(int words)
+	{
+		// Write a file of random animal names, with one in 8 misspelled so the failure path gets timed too.
+		std::FILE* file{ std::tmpfile() };
+		{
+			OutputBuffer out{ file };
+			for (int i{ 0 }; i < words; ++i)
+			{
+				const std::string_view name{ animalNames[Random::get(0, static_cast<int>(animalNames.size()) - 1)] };
+				out.append(Random::get(0, 7) == 0 ? name.substr(1) : name);
+				out.append('\n');
+			}
+		}
+
+		// Read it all back in one go and split it into lines.
+		std::fseek(file, 0, SEEK_END);
+		std::string text(static_cast<std::size_t>(std::ftell(file)), '\0');
+		std::rewind(file);
+		text.resize(std::fread(text.data(), 1, text.size(), file));
+		std::fclose(file);
+
+		std::vector<std::string_view> lines{};
+		lines.reserve(words);
+		for (std::size_t start{ 0 }, end{ text.find('\n') }; end != std::string::npos; start = end + 1, end = text.find('\n', start))
+			lines.push_back(std::string_view{ text }.substr(start, end - start));
+
+		long long linearSum{ 0 };
+		Timer timer{};
+		for (const std::string_view line : lines)
+			linearSum += linearFind(line).value_or(-1);
+		const double linearTime{ timer.elapsed() };
+
+		constexpr PerfectHash::Table<int, animalNames.size()> table{ animalNames };
+		long long hashSum{ 0 };
+		timer.reset();
+		for (const std::string_view line : lines)
+			hashSum += table.fromString(line).value_or(-1);
+		const double hashTime{ timer.elapsed() };
+
+		std::cout << "Parsing " << lines.size() << " animal names (" << (linearSum == hashSum ? "same results" : "RESULTS DIFFER") << ")\n";
+		std::cout << "linear scan:\t" << mops(lines.size(), linearTime) << " M parses/s\n";
+		std::cout << "PerfectHash:\t" << mops(lines.size(), hashTime) << " M parses/s\n";
+	}
+
+	void enumLookup(int lookups)
+	{
+		std::vector<OldMonster::Type> types(lookups);
+		for (OldMonster::Type& type : types)
+			type = static_cast<OldMonster::Type>(Random::get(0, OldMonster::maxMonsterTypes - 1));
+
+		// Add up the lengths so the lookups can't be optimized away.
+		std::size_t switchTotal{ 0 };
+		Timer timer{};
+		for (const OldMonster::Type type : types)
+			switchTotal += switchTypeString(type).size();
+		const double switchTime{ timer.elapsed() };
+
+		// builtIn() rather than global(), a monsters.txt could have different types.
+		const MonsterCatalog catalog{ MonsterCatalog::builtIn() };
+		std::size_t tableTotal{ 0 };
+		timer.reset();
+		for (const OldMonster::Type type : types)
+			tableTotal += catalog.name(static_cast<MonsterCatalog::TypeId>(type)).size();
+		const double tableTime{ timer.elapsed() };
+
+		std::cout << lookups << " monster type names (" << (switchTotal == tableTotal ? "same results" : "RESULTS DIFFER") << ")\n";
+		std::cout << "switch:\t\t" << mops(lookups, switchTime) << " M lookups/s\n";
+		std::cout << "MonsterCatalog:\t" << mops(lookups, tableTime) << " M lookups/s\n";
+	}
+
+	void monsterCatalog(int types)
+	{
+		// Numbered types with 1 to 4 names and roars each, picked from the built in ones.
+		const MonsterCatalog builtIn{ MonsterCatalog::builtIn() };
+		MonsterCatalog catalog{};
+		std::vector<std::string_view> names{};
+		std::vector<std::string_view> roars{};
+		std::string name{};
+		for (int i{ 0 }; i < types; ++i)
+		{
+			name = "monster #";
+			name += std::to_string(i);
+			names.clear();
+			for (int n{ Random::get(1, 4) }; n > 0; --n)
+				names.push_back(builtIn.monsterName(0, static_cast<std::size_t>(Random::get(0, static_cast<int>(builtIn.monsterNameCount(0)) - 1))));
+			roars.clear();
+			for (int r{ Random::get(1, 4) }; r > 0; --r)
+				roars.push_back(builtIn.roar(0, static_cast<std::size_t>(Random::get(0, static_cast<int>(builtIn.roarCount(0)) - 1))));
+			catalog.addType(name, Random::get(1, 200), names, roars);
+		}
+
+		const std::string textPath{ "catalog_benchmark.txt" };
+		const std::string binaryPath{ "catalog_benchmark.bin" };
+		if (!catalog.saveText(textPath) || !catalog.saveBinary(binaryPath))
+		{
+			std::cout << "Couldn't write the catalog files\n";
+			return;
+		}
+
+		Timer timer{};
+		const std::optional<MonsterCatalog> fromText{ MonsterCatalog::loadText(textPath) };
+		const double textTime{ timer.elapsed() };
+
+		timer.reset();
+		const std::optional<MonsterCatalog> fromBinary{ MonsterCatalog::loadBinary(binaryPath) };
+		const double binaryTime{ timer.elapsed() };
+
+		std::remove(textPath.c_str());
+		std::remove(binaryPath.c_str());
+
+		// Spot check the loaded tables against the original.
+		bool same{ fromText && fromBinary && fromText->size() == catalog.size() && fromBinary->size() == catalog.size() };
+		for (MonsterCatalog::TypeId id{ 0 }; same && id < catalog.size(); id += 997)
+		{
+			same = fromText->name(id) == catalog.name(id) && fromBinary->name(id) == catalog.name(id)
+				&& fromText->baseHp(id) == catalog.baseHp(id) && fromBinary->roarCount(id) == catalog.roarCount(id)
+				&& fromText->monsterName(id, 0) == catalog.monsterName(id, 0) && fromBinary->roar(id, 0) == catalog.roar(id, 0);
+		}
+
+		std::cout << "Loading a catalog of " << types << " monster types (" << (same ? "loaded correctly" : "LOAD FAILED") << ")\n";
+		std::cout << "text:\t" << textTime * 1000 << "ms\n";
+		std::cout << "binary:\t" << binaryTime * 1000 << "ms\n";
+	}
+
+	void combat(int encounters, int maxThreads)
+	{
+		const Combat::Config config{};
+		constexpr std::uint64_t seed{ 2024 };
+
+		std::cout << "Simulating " << encounters << " encounters of " << config.players << " players vs " << config.monsters << " monsters\n";
+		std::cout << "threads\tencounters/s\tsame as 1 thread\n";
+
+		std::vector<Combat::Result> first{};
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			Timer timer{};
+			std::vector<Combat::Result> results{ Combat::runMany(config, encounters, seed, threads) };
+			const double time{ timer.elapsed() };
+
+			if (threads == 1)
+				first = std::move(results);
+			const bool same{ threads == 1 || std::equal(first.begin(), first.end(), results.begin(), [](const Combat::Result& a, const Combat::Result& b) {
+				return a.ticks == b.ticks && a.playersLeft == b.playersLeft && a.monstersLeft == b.monstersLeft && a.damageDealt == b.damageDealt;
+			}) };
+
+			std::cout << threads << '\t' << encounters / time << "\t" << (same ? "yes" : "NO") << '\n';
+		}
+
+		if (first.empty())
+			return;
+
+		std::size_t wins{ 0 };
+		unsigned long long ticks{ 0 };
+		for (const Combat::Result& result : first)
+		{
+			wins += result.playersWon();
+			ticks += result.ticks;
+		}
+
+		std::vector<Combat::Event> log{};
+		const std::size_t replayed{ first.size() / 2 };
+		const Combat::Result again{ Combat::replay(config, seed, replayed, log) };
+
+		std::cout << "players won " << 100.0 * wins / first.size() << "%, average " << static_cast<double>(ticks) / first.size() << " ticks\n";
+		std::cout << "replay of encounter " << replayed << ": " << log.size() << " events, "
+			<< (again.ticks == first[replayed].ticks && again.damageDealt == first[replayed].damageDealt ? "matches" : "DOESN'T MATCH") << '\n';
+	}
+
+	void snapshots(int monsters, int forks, int maxThreads)
+	{
+		std::vector<Monster> horde{};
+		horde.reserve(monsters);
+		for (int i{ 0 }; i < monsters; ++i)
+			horde.push_back(MonsterGenerator::generate());
+
+		const Player player{ "Balance Tester" };
+		const GameState base{ GameState::capture(player, horde) };
+
+		std::vector<GameState> states{};
+		states.reserve(forks);
+		Timer timer{};
+		for (int i{ 0 }; i < forks; ++i)
+			states.push_back(base.fork());
+		const double forkTime{ timer.elapsed() };
+
+		// Every fork tries something different: spend some gold and hit 4 random monsters.
+		constexpr int writesPerFork{ 4 };
+		std::atomic<long long> survivors{ 0 };
+		timer.reset();
+		Parallel::forEachIndex(states.size(), maxThreads, [&](std::size_t index, int) {
+			GameState& state{ states[index] };
+			Combat::Rng rng{ index };
+			state.player.gold -= Potion::costs[index % Potion::max_types];
+			++state.player.inventory[index % Potion::max_types];
+			for (int i{ 0 }; i < writesPerFork; ++i)
+				state.monsters.mutate(rng.get(0, monsters - 1)).takeDamage(50);
+
+			long long alive{ 0 };
+			for (std::size_t m{ 0 }; m < state.monsters.size(); m += 97)
+				alive += state.monsters[m].isAlive();
+			survivors.fetch_add(alive, std::memory_order_relaxed);
+		});
+		const double writeTime{ timer.elapsed() };
+
+		std::size_t forkBytes{ 0 };
+		for (const GameState& state : states)
+			forkBytes += state.ownedBytes();
+		const double fullCopyBytes{ static_cast<double>(forks) * (sizeof(GameState) + sizeof(Monster) * monsters) };
+
+		// A plain copy of the monsters, for comparison.
+		timer.reset();
+		std::vector<Monster> copy{ horde };
+		const double copyTime{ timer.elapsed() };
+
+		std::cout << forks << " forks of a game state with " << monsters << " monsters (" << survivors << ")\n";
+		std::cout << "fork:\t\t" << forkTime / forks * 1e9 << " ns/fork\t(copying all " << copy.size() << " monsters: " << copyTime * 1e9 << " ns)\n";
+		std::cout << "first writes:\t" << writeTime / forks * 1e6 << " us/fork on " << maxThreads << " threads\n";
+		std::cout << "memory:\t\t" << forkBytes / 1e6 << " MB for all forks\t(full copies: " << fullCopyBytes / 1e6 << " MB)\n";
+	}
+
+	void shop(int players, int purchases, int maxThreads)
+	{
+		constexpr int startingGold{ 3'000 }; // low enough that some players run out
+
+		std::vector<Shop::Request> requests(purchases);
+		for (Shop::Request& request : requests)
+			request = Shop::Request{ static_cast<std::uint32_t>(Random::get(0, players - 1)), static_cast<Potion::Type>(Random::get(0, Potion::max_types - 1)) };
+		std::vector<Shop::Outcome> outcomes(purchases);
+
+		std::cout << purchases << " purchases spread over " << players << " players\n";
+		std::cout << "threads\tM purchases/s\tbought\tgold adds up\n";
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			Shop shop{ static_cast<std::size_t>(players), startingGold };
+			Timer timer{};
+			const std::size_t bought{ shop.processAll(requests, outcomes, threads) };
+			const double time{ timer.elapsed() };
+
+			// Every player's gold plus what they spent on potions should still be what they started with.
+			bool consistent{ true };
+			for (std::uint32_t player{ 0 }; player < static_cast<std::uint32_t>(players); ++player)
+			{
+				const Shop::PlayerState state{ shop.state(player) };
+				long long total{ state.gold };
+				for (const Potion::Type type : Potion::types)
+					total += static_cast<long long>(state.inventory[type]) * Potion::costs[type];
+				consistent = consistent && total == startingGold;
+			}
+
+			std::cout << threads << '\t' << mops(purchases, time) << "\t\t" << bought << '\t' << (consistent ? "yes" : "NO") << '\n';
+		}
+	}
+
+	void inventories(int players)
+	{
+		std::vector<std::array<int, Potion::max_types>> arrays(players);
+		std::vector<PotionInventory> packed(players);
+		std::vector<PackedInventory<1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1>> owned(players);
+		for (int i{ 0 }; i < players; ++i)
+		{
+			for (const Potion::Type type : Potion::types)
+			{
+				const int count{ Random::get(0, 20) };
+				arrays[i][type] = count;
+				packed[i].add(type, count);
+			}
+			for (int item{ 0 }; item < 16; ++item)
+				owned[i].add(item, Random::get(0, 1));
+		}
+
+		// Same loop as countInventory(), for every player.
+		Timer timer{};
+		std::uint64_t arrayTotal{ 0 };
+		for (const auto& inventory : arrays)
+		{
+			for (const int count : inventory)
+				arrayTotal += static_cast<std::uint64_t>(count);
+		}
+		const double arrayTime{ timer.elapsed() };
+
+		timer.reset();
+		const std::uint64_t packedTotal{ PotionInventory::countAll(packed) };
+		const double packedTime{ timer.elapsed() };
+
+		timer.reset();
+		const std::uint64_t ownedTotal{ decltype(owned)::value_type::countAll(owned) };
+		const double ownedTime{ timer.elapsed() };
+
+		std::cout << "Counting the potions of " << players << " players (" << (arrayTotal == packedTotal ? "same totals" : "TOTALS DIFFER") << ")\n";
+		std::cout << "std::array<int, 4>:\t" << sizeof(arrays[0]) << " bytes/player\t" << mops(players, arrayTime) << " M players/s\n";
+		std::cout << "PotionInventory:\t" << sizeof(packed[0]) << " bytes/player\t" << mops(players, packedTime) << " M players/s\n";
+		std::cout << "16 item bitset:\t\t" << sizeof(owned[0]) << " bytes/player\t" << mops(players, ownedTime) << " M players/s\t("
+			<< ownedTotal << " items owned)\n";
+	}
+
+	void inventoryAnalytics(int players, int maxThreads)
+	{
+		constexpr int itemTypes{ 16 };
+		std::vector<std::vector<int>> perPlayer(players, std::vector<int>(itemTypes));
+		InventoryColumns columns{ itemTypes };
+		columns.reserve(players);
+		for (auto& inventory : perPlayer)
+		{
+			for (int& count : inventory)
+				count = Random::get(0, 40);
+			columns.addPlayer(inventory);
+		}
+
+		// Same loop as countInventory(), for every player, one inventory at a time.
+		Timer timer{};
+		std::vector<std::uint32_t> oldTotals(players);
+		std::uint64_t oldTotal{ 0 };
+		for (int player{ 0 }; player < players; ++player)
+		{
+			int sum{ 0 };
+			for (const int count : perPlayer[player])
+				sum += count;
+			oldTotals[player] = static_cast<std::uint32_t>(sum);
+			oldTotal += static_cast<std::uint64_t>(sum);
+		}
+		const double oldTime{ timer.elapsed() };
+
+		// Top 10 holders of item 0 the obvious way: sort everybody.
+		timer.reset();
+		std::vector<std::uint32_t> order(players);
+		for (int player{ 0 }; player < players; ++player)
+			order[player] = static_cast<std::uint32_t>(player);
+		const std::size_t k{ std::min<std::size_t>(10, order.size()) };
+		std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](std::uint32_t a, std::uint32_t b) {
+			return perPlayer[a][0] != perPlayer[b][0] ? perPlayer[a][0] > perPlayer[b][0] : a < b;
+		});
+		order.resize(k);
+		const double oldTopTime{ timer.elapsed() };
+
+		std::cout << players << " players, " << itemTypes << " item types. vector<vector<int>> is " << sizeof(int) * itemTypes
+			<< " bytes/player plus a heap block, InventoryColumns is " << itemTypes << " bytes/player\n";
+		std::cout << "per player loop:\t" << mops(players, oldTime) << " M players/s\ttop 10: " << oldTopTime * 1000 << " ms\n";
+		std::cout << "threads\ttotal M players/s\tplayerTotals M players/s\thistogram ms\ttop 10 ms\tsame results\n";
+
+		std::vector<std::uint32_t> newTotals(players);
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			timer.reset();
+			const std::uint64_t total{ InventoryAnalytics::total(columns, threads) };
+			const double totalTime{ timer.elapsed() };
+
+			timer.reset();
+			InventoryAnalytics::playerTotals(columns, newTotals, threads);
+			const double playerTime{ timer.elapsed() };
+
+			timer.reset();
+			const std::array<std::uint64_t, 256> histogram{ InventoryAnalytics::histogram(columns, 0, threads) };
+			const double histogramTime{ timer.elapsed() };
+
+			timer.reset();
+			const std::vector<std::uint32_t> top{ InventoryAnalytics::topK(columns, 0, 10, threads) };
+			const double topTime{ timer.elapsed() };
+
+			std::uint64_t histogramPlayers{ 0 };
+			for (const std::uint64_t count : histogram)
+				histogramPlayers += count;
+			const bool same{ total == oldTotal && newTotals == oldTotals && top == order && histogramPlayers == static_cast<std::uint64_t>(players) };
+
+			std::cout << threads << '\t' << mops(players, totalTime) << "\t\t\t" << mops(players, playerTime) << "\t\t\t"
+				<< histogramTime * 1000 << "\t\t" << topTime * 1000 << "\t\t" << (same ? "yes" : "NO") << '\n';
+		}
+	}
+
+	void priceTable(int readsPerThread, int maxThreads)
+	{
+		std::cout << "Reading all the potion prices while another thread keeps changing them\n";
+		std::cout << "readers\tmutex M reads/s\tshared_mutex M reads/s\tPriceTable M reads/s\ttorn reads\tPriceTable updates\n";
+
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			std::mutex mutex{};
+			PriceTable::Prices lockedPrices{ Potion::costs };
+			const PriceReadResult locked{ timePriceReads(threads, readsPerThread,
+				[&] {
+					std::lock_guard lock{ mutex };
+					return lockedPrices;
+				},
+				[&](int version) {
+					std::lock_guard lock{ mutex };
+					lockedPrices.fill(version);
+				}) };
+
+			std::shared_mutex sharedMutex{};
+			PriceTable::Prices sharedPrices{ Potion::costs };
+			const PriceReadResult shared{ timePriceReads(threads, readsPerThread,
+				[&] {
+					std::shared_lock lock{ sharedMutex };
+					return sharedPrices;
+				},
+				[&](int version) {
+					std::unique_lock lock{ sharedMutex };
+					sharedPrices.fill(version);
+				}) };
+
+			PriceTable table{};
+			const PriceReadResult lockFree{ timePriceReads(threads, readsPerThread,
+				[&] { return table.prices(); },
+				[&](int version) {
+					PriceTable::Prices prices{};
+					prices.fill(version);
+					table.publish(prices);
+				}) };
+
+			const double reads{ static_cast<double>(threads) * readsPerThread };
+			std::cout << threads << '\t' << mops(reads, locked.seconds) << "\t\t" << mops(reads, shared.seconds) << "\t\t\t"
+				<< mops(reads, lockFree.seconds) << "\t\t\t" << locked.torn + shared.torn + lockFree.torn << "\t\t" << lockFree.versions << '\n';
+		}
+	}
+
+	void itemPrint(int players)
+	{
+		noteAllocationCounting();
+
+		std::vector<std::vector<int>> inventories(players, std::vector<int>(Items::max_value));
+		for (auto& inventory : inventories)
+		{
+			for (int& count : inventory)
+				count = Random::get(0, 3);
+		}
+		const double lines{ static_cast<double>(players) * static_cast<double>(Items::max_value) };
+
+		// The old version writes to std::cout, so point std::cout at the null device while it runs.
+		std::ofstream stream{ nullDevice };
+		std::streambuf* const coutBuffer{ std::cout.rdbuf(stream.rdbuf()) };
+		unsigned long long allocations{ allocationCount() };
+		Timer timer{};
+		for (const auto& inventory : inventories)
+			oldPrintSpecifics(inventory);
+		std::cout.flush();
+		const double oldTime{ timer.elapsed() };
+		const unsigned long long oldAllocations{ allocationCount() - allocations };
+		std::cout.rdbuf(coutBuffer);
+
+		std::FILE* file{ std::fopen(nullDevice, "wb") };
+		allocations = allocationCount();
+		timer.reset();
+		Items::printSpecifics(inventories, file);
+		const double newTime{ timer.elapsed() };
+		// The only allocation should be the OutputBuffer itself.
+		const unsigned long long newAllocations{ allocationCount() - allocations };
+		std::fclose(file);
+
+		std::cout << "Printing the inventories of " << players << " players (" << static_cast<long long>(players) * Items::max_value << " lines)\n";
+		std::cout << "old printSpecifics():\t" << mops(lines, oldTime) << " Mlines/s\t" << oldAllocations << " allocations\n";
+		std::cout << "Items::printSpecifics():\t" << mops(lines, newTime) << " Mlines/s\t" << newAllocations << " allocations\n";
+	}
+
+	void playerStore(int players, int updatesPerThread, int maxThreads)
+	{
+		const std::filesystem::path directory{ std::filesystem::temp_directory_path() / "PlayerStoreBenchmark" };
+		std::error_code error{};
+		std::filesystem::remove_all(directory, error);
+
+		{
+			std::unique_ptr<PlayerStore> store{ PlayerStore::open(directory) };
+			if (!store)
+			{
+				std::cout << "Couldn't open a player store in " << directory << '\n';
+				return;
+			}
+
+			Timer timer{};
+			for (int i{ 0 }; i < players; ++i)
+				store->add(Player{ "Player" + std::to_string(i) });
+			store->snapshot();
+			std::cout << "Adding " << players << " players and writing a snapshot: " << timer.elapsed() << "s\n";
+
+			// Every update waits for its own change to be on disk, like a purchase that has to be saved before
+			// the player is told it went through. With one thread that's one fsync per update.
+			std::cout << "threads\tdurable updates/s\tupdates per fsync\n";
+			for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+			{
+				const std::uint64_t syncsBefore{ store->syncCount() };
+				std::atomic<int> nextThread{ 0 };
+				const double time{ timeThreads(threads, [&] {
+					const int thread{ nextThread.fetch_add(1) };
+					for (int i{ 0 }; i < updatesPerThread; ++i)
+					{
+						const auto id{ static_cast<PlayerStore::PlayerId>((thread * updatesPerThread + i) % players) };
+						store->sync(store->update(id, i, PotionInventory{}));
+					}
+				}) };
+
+				const double updates{ static_cast<double>(threads) * updatesPerThread };
+				const std::uint64_t syncs{ store->syncCount() - syncsBefore };
+				std::cout << threads << '\t' << updates / time << "\t\t" << updates / static_cast<double>(syncs > 0 ? syncs : 1) << '\n';
+			}
+		}
+
+		{
+			Timer timer{};
+			const std::unique_ptr<PlayerStore> reloaded{ PlayerStore::open(directory) };
+			std::cout << "Reloading " << (reloaded ? reloaded->size() : 0) << " players: " << timer.elapsed() << "s\n";
+		}
+		std::filesystem::remove_all(directory, error);
+	}
+
+	void playerIndex(int players, int lookups)
+	{
+		noteAllocationCounting();
+
+		// Names longer than std::string's small string buffer, so building a std::string to look one up allocates.
+		std::vector<std::string> names{};
+		names.reserve(players);
+		for (int i{ 0 }; i < players; ++i)
+			names.push_back("Wandering adventurer " + std::to_string(i));
+
+		std::vector<Player> roster{};
+		roster.reserve(players);
+		PlayerIndex index{};
+		index.reserve(players);
+		std::unordered_map<std::string, Player> map{};
+		for (int i{ 0 }; i < players; ++i)
+		{
+			roster.emplace_back(names[i]);
+			index.insert(names[i], static_cast<std::uint32_t>(i));
+			map.emplace(names[i], roster.back());
+		}
+
+		// 3 in 4 lookups find somebody.
+		std::vector<std::string> missing{};
+		for (int i{ 0 }; i < players / 3 + 1; ++i)
+			missing.push_back("Wandering adventurer " + std::to_string(players + i));
+		std::vector<std::string_view> queries(lookups);
+		for (std::string_view& query : queries)
+			query = Random::get(0, 3) == 0 ? missing[Random::get(0, static_cast<int>(missing.size()) - 1)] : names[Random::get(0, players - 1)];
+
+		// unordered_map<std::string, ...>::find() needs a std::string, so each string_view gets copied into one.
+		unsigned long long allocations{ allocationCount() };
+		Timer timer{};
+		long long mapGold{ 0 };
+		for (const std::string_view query : queries)
+		{
+			if (const auto found{ map.find(std::string{ query }) }; found != map.end())
+				mapGold += found->second.getGold();
+		}
+		const double mapTime{ timer.elapsed() };
+		const unsigned long long mapAllocations{ allocationCount() - allocations };
+
+		allocations = allocationCount();
+		timer.reset();
+		long long indexGold{ 0 };
+		for (const std::string_view query : queries)
+		{
+			if (const std::optional<std::uint32_t> slot{ index.find(query) })
+				indexGold += roster[*slot].getGold();
+		}
+		const double indexTime{ timer.elapsed() };
+		const unsigned long long indexAllocations{ allocationCount() - allocations };
+
+		std::cout << "Finding players by name among " << players << " players (" << (mapGold == indexGold ? "same results" : "RESULTS DIFFER") << ")\n";
+		std::cout << "unordered_map:\t" << mops(lookups, mapTime) << " M lookups/s\t" << mapAllocations << " allocations\n";
+		std::cout << "PlayerIndex:\t" << mops(lookups, indexTime) << " M lookups/s\t" << indexAllocations << " allocations\n";
+	}
+
+	void commandReader(int commands)
+	{
+		// A script of guesses for getUserInt(): mostly good ones, some with junk after the number, some that aren't
+		// numbers and some out of range.
+		const std::filesystem::path path{ std::filesystem::temp_directory_path() / "CommandReaderBenchmark.txt" };
+		std::FILE* script{ std::fopen(path.string().c_str(), "wb") };
+		if (!script)
+			return;
+		{
+			constexpr std::array<std::string_view, 6> extras{ "", "", "", " and some words", "\t", " 12" };
+			OutputBuffer out{ script };
+			for (int i{ 0 }; i < commands; ++i)
+			{
+				switch (Random::get(0, 9))
+				{
+				case 0:
+					out.append("abc");
+					break;
+				case 1:
+					out.appendNumber(Random::get(10, 1000));
+					break;
+				default:
+					out.append("  ");
+					out.appendNumber(Random::get(0, 9));
+					out.append(extras[Random::get(0, 5)]);
+				}
+				out.append('\n');
+			}
+		}
+		std::fclose(script);
+
+		Timer timer{};
+		GuessCounts streamCounts{};
+		{
+			std::ifstream in{ path };
+			streamCounts = streamGuesses(in);
+		}
+		const double streamTime{ timer.elapsed() };
+
+		timer.reset();
+		GuessCounts bufferedCounts{};
+		if (std::FILE* file{ std::fopen(path.string().c_str(), "rb") })
+		{
+			CommandReader reader{ file };
+			bufferedCounts = readerGuesses(reader);
+			std::fclose(file);
+		}
+		const double bufferedTime{ timer.elapsed() };
+
+		timer.reset();
+		GuessCounts mappedCounts{};
+		if (const std::unique_ptr<CommandReader> reader{ CommandReader::open(path) })
+			mappedCounts = readerGuesses(*reader);
+		const double mappedTime{ timer.elapsed() };
+
+		std::error_code error{};
+		std::filesystem::remove(path, error);
+
+		const bool same{ streamCounts == bufferedCounts && bufferedCounts == mappedCounts };
+		std::cout << "Reading " << commands << " guesses (" << (same ? "same results" : "RESULTS DIFFER") << ", "
+			<< streamCounts.valid << " valid)\n";
+		std::cout << "std::ifstream >> int + ignore():\t" << mops(commands, streamTime) << " M commands/s\n";
+		std::cout << "CommandReader over a FILE*:\t\t" << mops(commands, bufferedTime) << " M commands/s\n";
+		std::cout << "CommandReader over a mapped file:\t" << mops(commands, mappedTime) << " M commands/s\n";
+	}
+	void hilo(int games, int maxThreads)
+	{
+		const Hilo::Config config{};
+		constexpr std::uint64_t seed{ 2024 };
+
+		// The 8.x hilo() loop with std::cin swapped for a binary search guess and the output taken out.
+		// Random::get() is one std::mt19937 shared by every game, so this can only run on one thread.
+		Timer timer{};
+		long long oldWins{ 0 };
+		for (int game{ 0 }; game < games; ++game)
+		{
+			const int x{ Random::get(config.low, config.high) };
+			int low{ config.low };
+			int high{ config.high };
+			for (int i{ 1 }; i <= config.guesses; ++i)
+			{
+				const int input{ low + (high - low) / 2 };
+				if (input < x)
+					low = input + 1;
+				else if (input == x)
+				{
+					++oldWins;
+					break;
+				}
+				else
+					high = input - 1;
+			}
+		}
+		const double oldTime{ timer.elapsed() };
+
+		std::cout << "Playing " << games << " games of hilo, " << config.low << " to " << config.high << " in " << config.guesses << " guesses\n";
+		std::cout << "strategy\t\twin rate\tavg guesses\tM games/s(1 thread)\n";
+		std::cout << "old loop, binary\t" << 100.0 * oldWins / games << "%\t\t-\t\t" << mops(games, oldTime) << '\n';
+
+		auto row{ [&](const char* name, const auto& strategy) {
+			timer.reset();
+			const Hilo::Report report{ Hilo::runMany(config, strategy, games, seed, 1) };
+			const double time{ timer.elapsed() };
+			std::cout << name << 100.0 * report.winRate() << "%\t\t" << report.averageGuesses() << "\t\t" << mops(games, time) << '\n';
+			return report;
+		} };
+		const Hilo::Report binary{ row("binary search\t\t", Hilo::BinarySearch{}) };
+		row("random\t\t\t", Hilo::RandomGuess{});
+		row("biased 0.25\t\t", Hilo::Biased{ 0.25 });
+		row("biased 0.1\t\t", Hilo::Biased{ 0.1 });
+
+		std::cout << "binary search wins by guess:";
+		for (std::size_t n{ 1 }; n < binary.winsAfter.size(); ++n)
+			std::cout << ' ' << n << ':' << binary.winsAfter[n];
+		std::cout << '\n';
+
+		std::cout << "threads\tM games/s(random)\tsame as 1 thread\n";
+		Hilo::Report first{};
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			timer.reset();
+			const Hilo::Report report{ Hilo::runMany(config, Hilo::RandomGuess{}, games, seed, threads) };
+			const double time{ timer.elapsed() };
+
+			if (threads == 1)
+				first = report;
+			const bool same{ report.games == first.games && report.wins == first.wins && report.winsAfter == first.winsAfter };
+			std::cout << threads << '\t' << mops(games, time) << "\t\t\t" << (same ? "yes" : "NO") << '\n';
+		}
+	}
+	void expressions(int rows, int maxThreads)
+	{
+		// Random operands, small enough that calculate()'s int math never overflows.
+		// The divisor is a constant so calculate() never divides by 0.
+		constexpr int columnCount{ 3 };
+		std::vector<std::vector<int>> columns(columnCount, std::vector<int>(static_cast<std::size_t>(rows)));
+		Combat::Rng rng{ 2024 };
+		for (auto& column : columns)
+		{
+			for (int& value : column)
+				value = rng.get(-1000, 1000);
+		}
+		const std::vector<std::span<const int>> views(columns.begin(), columns.end());
+
+		const char* const source{ "a * 3 + b - c * 2 + 7 % 11 - a" };
+		const std::optional<Expression> expression{ Expression::compile(source) };
+		if (!expression)
+			return;
+
+		// What calculate() would get called with, a step per (op, operand). Operands are a column or a constant.
+		struct CalculateStep
+		{
+			char op{};
+			int column{}; // -1 for the constant
+			int constant{};
+		};
+		const std::vector<CalculateStep> steps{ { '*', -1, 3 }, { '+', 1, 0 }, { '-', 2, 0 }, { '*', -1, 2 }, { '+', -1, 7 },
+			{ '%', -1, 11 }, { '-', 0, 0 } };
+
+		Timer timer{};
+		std::vector<int> old(static_cast<std::size_t>(rows));
+		for (std::size_t row{ 0 }; row < old.size(); ++row)
+		{
+			int value{ columns[0][row] };
+			for (const CalculateStep& step : steps)
+				value = oldCalculate(value, step.column < 0 ? step.constant : columns[static_cast<std::size_t>(step.column)][row], step.op);
+			old[row] = value;
+		}
+		const double oldTime{ timer.elapsed() };
+
+		timer.reset();
+		std::vector<int> rowByRow(static_cast<std::size_t>(rows));
+		for (std::size_t row{ 0 }; row < rowByRow.size(); ++row)
+		{
+			const int values[columnCount]{ columns[0][row], columns[1][row], columns[2][row] };
+			rowByRow[row] = expression->evaluate(values);
+		}
+		const double rowTime{ timer.elapsed() };
+
+		std::cout << "Evaluating " << source << " for " << rows << " rows\n";
+		std::cout << "calculate() per op per row:\t" << mops(rows, oldTime) << " M rows/s\n";
+		std::cout << "Expression one row at a time:\t" << mops(rows, rowTime) << " M rows/s\t" << (rowByRow == old ? "same" : "DIFFERENT") << '\n';
+		std::cout << "threads\tExpression over columns(M rows/s)\n";
+
+		std::vector<int> out(static_cast<std::size_t>(rows));
+		for (int threads{ 1 }; threads <= maxThreads; threads *= 2)
+		{
+			std::fill(out.begin(), out.end(), 0);
+			timer.reset();
+			expression->evaluate(views, out, threads);
+			const double time{ timer.elapsed() };
+			std::cout << threads << '\t' << mops(rows, time) << '\t' << (out == old ? "same" : "DIFFERENT") << '\n';
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+// Benchmarks for the faster versions of the quiz code. Each one prints its own results to std::cout.
+// They are called from the #if 0 blocks in the main() functions of the notes files.
+// The ones that report heap allocations only count them when built with BENCHMARKS_COUNT_ALLOCATIONS defined.
+namespace Benchmarks
+{
+	// Single std::atomic<int> vs ShardedCounter, run at 1, 2, 4, ... up to maxThreads threads.
+	void counters(int maxThreads, int incrementsPerThread);
+
+	// isPrime() from 8.x Q2 vs Primes::Sieve, on random numbers below maxValue.
+	void primes(int queries, int maxValue);
+
+	// Primes::countPrimes(0, limit) at 1, 2, 4, ... up to maxThreads threads.
+	void primeCountScaling(unsigned long long limit, int maxThreads);
+
+	// Sums::sumSpan over megabytes worth of ints, in GB/s, at 1, 2, 4, ... up to maxThreads threads.
+	void sumSpanThroughput(int megabytes, int maxThreads);
+
+	// fizzbuzzpop() written with std::ostream << vs FizzBuzz::Engine, both writing lines to the null device.
+	void fizzbuzz(long long lines);
+
+	// std::vector<Monster> vs MonsterStore: bytes per monster, and time per tick of damaging everyone and counting survivors.
+	void monsterStore(int monsters, int ticks);
+
+	// Heap allocations per call of the old std::string MonsterGenerator::generate() vs the StringPool one.
+	void monsterAllocations(int calls);
+
+	// MonsterGenerator::generateBatch() in monsters/sec at 1, 2, 4, ... up to maxThreads threads,
+	// compared against calling generate() in a loop.
+	void monsterBatch(int monsters, int maxThreads);
+
+	// Setting up and tearing down one encounter(players, named monsters and a combat log) with the global heap
+	// vs a FrameArena that gets reset() after every encounter. Reports time and heap allocations per encounter.
+	void encounters(int count, int playersPerEncounter, int monstersPerEncounter);
+
+	// Monster::print() in a loop vs printMonsters(), in lines/sec, both writing to the null device.
+	void monsterPrint(int monsters);
+
+	// Parsing animal names(17.6 Q1) from a file of words, looping over the name table vs PerfectHash::Table, in parses/sec.
+	void enumParsing(int words);
+
+	// The old switch in Monster::getTypeString() vs the MonsterCatalog table it uses now, on random monster types.
+	void enumLookup(int lookups);
+
+	// Load time for a MonsterCatalog with this many types, from the text format and from the binary format.
+	void monsterCatalog(int types);
+
+	// Combat::runMany() in encounters/sec at 1, 2, 4, ... up to maxThreads threads, checking that every thread count
+	// gives the same results and that replay() reproduces them.
+	void combat(int encounters, int maxThreads);
+
+	// Forking a GameState with this many monsters forks times, then changing a few monsters in every fork on maxThreads
+	// threads. Reports fork cost, time for the writes, and memory used by the forks vs full copies.
+	void snapshots(int monsters, int forks, int maxThreads);
+
+	// Shop::processAll() in purchases/sec at 1, 2, 4, ... up to maxThreads threads, with random purchases spread over
+	// players. Checks afterwards that no gold went missing.
+	void shop(int players, int purchases, int maxThreads);
+
+	// Bytes per player and items counted per second for std::array<int, 4> inventories(the old Player::m_inventory)
+	// vs PotionInventory, and for a 64 item "owns it" bitset.
+	void inventories(int players);
+
+	// InventoryAnalytics total(), playerTotals(), histogram() and topK() at 1, 2, 4, ... up to maxThreads threads vs
+	// going through a vector<vector<int>> of inventories one player at a time. Checks both give the same answers.
+	void inventoryAnalytics(int players, int maxThreads);
+
+	// Reading every potion price from a PriceTable vs an array behind a std::mutex or std::shared_mutex, with 1, 2, 4, ...
+	// up to maxThreads reader threads while one writer thread publishes new prices nonstop. Also checks that no read
+	// ever sees prices from two different versions.
+	void priceTable(int readsPerThread, int maxThreads);
+
+	// Lines/sec and heap allocations printing the 16.x Q2 inventories of this many players with the old
+	// printSpecifics()(std::cout, a std::string per item) vs Items::printSpecifics(). Output goes to the null device.
+	void itemPrint(int players);
+
+	// Adds this many players to a PlayerStore in the temp directory, then durable updates/sec and updates per fsync
+	// with 1, 2, 4, ... up to maxThreads threads each doing updatesPerThread update() + sync(), then how long it
+	// takes to open the store again.
+	void playerStore(int players, int updatesPerThread, int maxThreads);
+
+	// Lookups/sec finding players by name(from a std::string_view, 3 in 4 found) in a PlayerIndex vs an
+	// std::unordered_map<std::string, Player>.
+	void playerIndex(int players, int lookups);
+
+	// Commands/sec reading a script of getUserInt() guesses with std::ifstream >> int and ignore() vs CommandReader
+	// reading a FILE* and a mapped file. All three have to agree on which guesses were valid.
+	void commandReader(int commands);
+
+	// Games/sec for Hilo::runMany() with each of the built-in strategies, with their win rates, vs the 8.x hilo() loop
+	// using Random::get(). Then Hilo::runMany() at 1, 2, 4, ... up to maxThreads threads, checking every thread count
+	// gives the same Report.
+	void hilo(int games, int maxThreads);
+
+	// Rows/sec working out one expression for this many rows of 3 random columns: calculate() for every op of every
+	// row vs Expression one row at a time vs Expression over the columns at 1, 2, 4, ... up to maxThreads threads.
+	// All of them have to give the same results.
+	void expressions(int rows, int maxThreads);
+}
+
+#endif
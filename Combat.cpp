@@ -0,0 +1,129 @@
+#include "Combat.h"
+
+namespace Combat
+{
+	void Simulation::Team::reset(std::size_t count)
+	{
+		// resize() keeps the capacity, so after the first encounter none of these allocate.
+		hp.resize(count);
+		damageMin.resize(count);
+		damageMax.resize(count);
+		living.resize(count);
+		for (std::size_t i{ 0 }; i < count; ++i)
+			living[i] = static_cast<std::uint32_t>(i);
+		incoming.clear();
+	}
+
+	void Simulation::attack(const Team& attackers, Team& defenders, Rng& rng)
+	{
+		const auto targets{ static_cast<int>(defenders.living.size()) };
+		for (const std::uint32_t attacker : attackers.living)
+		{
+			const std::uint32_t target{ defenders.living[rng.get(0, targets - 1)] };
+			const int amount{ rng.get(attackers.damageMin[attacker], attackers.damageMax[attacker]) };
+			defenders.incoming.push_back(DamageEvent{ attacker, target, amount });
+		}
+	}
+
+	std::uint64_t Simulation::applyDamage(Team& team, Side side, std::uint32_t tick, std::vector<Event>* log)
+	{
+		std::uint64_t total{ 0 };
+		for (const DamageEvent& event : team.incoming)
+		{
+			// Damage past 0 hp isn't counted, and hp stops at 0 like Monster::takeDamage().
+			const std::int32_t dealt{ event.amount < team.hp[event.target] ? event.amount : team.hp[event.target] };
+			team.hp[event.target] -= dealt;
+			total += static_cast<std::uint64_t>(dealt);
+		}
+
+		if (log)
+		{
+			for (const DamageEvent& event : team.incoming)
+				log->push_back(Event{ tick, Event::damage, side, event.attacker, event.target, event.amount });
+		}
+		team.incoming.clear();
+		return total;
+	}
+
+	void Simulation::removeDead(Team& team, Side side, std::uint32_t tick, std::vector<Event>* log)
+	{
+		// Keep the living in their original order(so replays match), compacting in place.
+		std::size_t kept{ 0 };
+		for (const std::uint32_t index : team.living)
+		{
+			if (team.hp[index] > 0)
+				team.living[kept++] = index;
+			else if (log)
+				log->push_back(Event{ tick, Event::death, side, 0, index, 0 });
+		}
+		team.living.resize(kept);
+	}
+
+	Result Simulation::run(const Config& config, std::uint64_t seed, std::uint64_t index, std::vector<Event>* log)
+	{
+		// Mix the encounter index into the seed so neighbouring encounters get unrelated streams.
+		Rng rng{ Rng{ seed ^ (index * 0xD1B54A32D192ED03ull) }.next() };
+
+		m_players.reset(static_cast<std::size_t>(config.players));
+		for (std::size_t i{ 0 }; i < m_players.hp.size(); ++i)
+		{
+			m_players.hp[i] = rng.get(config.playerHpMin, config.playerHpMax);
+			m_players.damageMin[i] = config.playerDamageMin;
+			m_players.damageMax[i] = config.playerDamageMax;
+		}
+
+		m_monsters.reset(static_cast<std::size_t>(config.monsters));
+		for (std::size_t i{ 0 }; i < m_monsters.hp.size(); ++i)
+		{
+			m_monsters.hp[i] = rng.get(config.monsterHpMin, config.monsterHpMax);
+			m_monsters.damageMin[i] = config.monsterDamageMin;
+			m_monsters.damageMax[i] = config.monsterDamageMax;
+		}
+
+		Result result{};
+		std::uint32_t tick{ 0 };
+		while (tick < static_cast<std::uint32_t>(config.maxTicks) && !m_players.living.empty() && !m_monsters.living.empty())
+		{
+			attack(m_players, m_monsters, rng);
+			attack(m_monsters, m_players, rng);
+
+			result.damageDealt += applyDamage(m_monsters, Side::monsters, tick, log);
+			result.damageDealt += applyDamage(m_players, Side::players, tick, log);
+
+			removeDead(m_monsters, Side::monsters, tick, log);
+			removeDead(m_players, Side::players, tick, log);
+			++tick;
+		}
+
+		result.ticks = tick;
+		result.playersLeft = static_cast<std::uint32_t>(m_players.living.size());
+		result.monstersLeft = static_cast<std::uint32_t>(m_monsters.living.size());
+		return result;
+	}
+
+	std::vector<Result> runMany(const Config& config, std::size_t count, std::uint64_t seed, int threadCount)
+	{
+		std::vector<Result> results(count);
+		if (threadCount < 1)
+			threadCount = 1;
+
+		// Encounters are handed out in chunks so threads aren't fighting over the shared counter for every one.
+		constexpr std::size_t chunkSize{ 256 };
+		const std::size_t chunks{ (count + chunkSize - 1) / chunkSize };
+		std::vector<Simulation> simulations(static_cast<std::size_t>(threadCount));
+
+		Parallel::forEachIndex(chunks, threadCount, [&](std::size_t chunk, int threadIndex) {
+			Simulation& simulation{ simulations[threadIndex] };
+			const std::size_t end{ (chunk + 1) * chunkSize < count ? (chunk + 1) * chunkSize : count };
+			for (std::size_t i{ chunk * chunkSize }; i < end; ++i)
+				results[i] = simulation.run(config, seed, i);
+		});
+		return results;
+	}
+
+	Result replay(const Config& config, std::uint64_t seed, std::uint64_t index, std::vector<Event>& log)
+	{
+		Simulation simulation{};
+		return simulation.run(config, seed, index, &log);
+	}
+}
@@ -0,0 +1,141 @@
+#ifndef COMBAT_H
+#define COMBAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Parallel.h"
+
+// Offline Monster vs Player battle simulations, for balancing.
+// Each encounter runs in fixed ticks. Every tick has three phases:
+//	1. attack: every living fighter picks a living target on the other side and queues a damage event.
+//		All attacks are decided from the state at the start of the tick, so the order fighters act in doesn't matter.
+//	2. damage: the queued events are applied in one pass over the hp arrays.
+//	3. death: one pass drops everyone at 0 hp from the living lists and queues a death event for each.
+// State is kept as arrays per field("structure of arrays") like MonsterStore, and the event queues are reused
+// between ticks and between encounters, so a running simulation doesn't allocate.
+//
+// Every encounter gets its own random number generator seeded from (seed, encounter index), so results don't depend
+// on how many threads ran them or in what order. replay() reruns a single encounter and records every event.
+namespace Combat
+{
+	struct Config
+	{
+		int players{ 4 };
+		int monsters{ 16 };
+		int playerHpMin{ 150 };
+		int playerHpMax{ 250 };
+		int playerDamageMin{ 10 };
+		int playerDamageMax{ 30 };
+		// Monsters roll hp like MonsterGenerator::generate(), but never start dead.
+		int monsterHpMin{ 1 };
+		int monsterHpMax{ 100 };
+		int monsterDamageMin{ 2 };
+		int monsterDamageMax{ 8 };
+		// Encounters still going after this many ticks end in a draw.
+		int maxTicks{ 1000 };
+	};
+
+	enum class Side : std::uint8_t
+	{
+		players,
+		monsters,
+	};
+
+	struct Result
+	{
+		std::uint32_t ticks{};
+		std::uint32_t playersLeft{};
+		std::uint32_t monstersLeft{};
+		std::uint64_t damageDealt{};
+
+		bool playersWon() const { return monstersLeft == 0 && playersLeft > 0; }
+	};
+
+	// What replay() records. For deaths attacker is unused and amount is 0.
+	struct Event
+	{
+		enum Kind : std::uint8_t
+		{
+			damage,
+			death,
+		};
+
+		std::uint32_t tick{};
+		Kind kind{};
+		Side targetSide{}; // side of the fighter taking the damage or dying
+		std::uint32_t attacker{};
+		std::uint32_t target{};
+		std::int32_t amount{};
+	};
+
+	// Small, fast generator(SplitMix64). std::mt19937 is 5KB of state, which is a lot to seed per encounter.
+	class Rng
+	{
+	private:
+		std::uint64_t m_state{};
+
+	public:
+		explicit Rng(std::uint64_t seed) : m_state{ seed } {}
+
+		std::uint64_t next()
+		{
+			std::uint64_t z{ m_state += 0x9E3779B97F4A7C15ull };
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		// Uniform-ish int in [min, max]. Uses the multiply-shift trick instead of %, the bias is far too small to matter here.
+		int get(int min, int max)
+		{
+			const auto range{ static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min + 1) };
+			return min + static_cast<int>(((next() >> 32) * range) >> 32);
+		}
+	};
+
+	// One encounter's state and event queues. Reuse a Simulation to run many encounters without allocating.
+	class Simulation
+	{
+	private:
+		struct DamageEvent
+		{
+			std::uint32_t attacker{};
+			std::uint32_t target{};
+			std::int32_t amount{};
+		};
+
+		// One side of the fight. living holds indices of fighters still above 0 hp.
+		struct Team
+		{
+			std::vector<std::int32_t> hp{};
+			std::vector<std::int32_t> damageMin{};
+			std::vector<std::int32_t> damageMax{};
+			std::vector<std::uint32_t> living{};
+			std::vector<DamageEvent> incoming{}; // damage events aimed at this team this tick
+
+			void reset(std::size_t count);
+		};
+
+		Team m_players{};
+		Team m_monsters{};
+
+		void attack(const Team& attackers, Team& defenders, Rng& rng);
+		std::uint64_t applyDamage(Team& team, Side side, std::uint32_t tick, std::vector<Event>* log);
+		void removeDead(Team& team, Side side, std::uint32_t tick, std::vector<Event>* log);
+
+	public:
+		// Runs encounter number index of the batch started with seed. If log isn't null every event is appended to it.
+		Result run(const Config& config, std::uint64_t seed, std::uint64_t index, std::vector<Event>* log = nullptr);
+	};
+
+	// Runs encounters [0, count) on up to threadCount threads. results[i] is encounter i.
+	std::vector<Result> runMany(const Config& config, std::size_t count, std::uint64_t seed, int threadCount = Parallel::defaultThreadCount());
+
+	// Reruns encounter index of the batch started with seed, recording every event.
+	// Gives the same Result as runMany() did for that encounter.
+	Result replay(const Config& config, std::uint64_t seed, std::uint64_t index, std::vector<Event>& log);
+}
+
+#endif
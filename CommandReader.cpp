@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+#include "CommandReader.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace {
+	bool isSpace(char c) {
+		return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	//Reads whatever is available, up to count bytes. Unlike fread this doesn't wait for the whole count,
+	//so typing a line at the keyboard hands it over right away. Returns 0 at the end of the input.
+	std::size_t readSome(std::FILE* file, char* out, std::size_t count) {
+#ifdef _WIN32
+		const int read{ _read(_fileno(file), out, static_cast<unsigned int>(std::min<std::size_t>(count, 1u << 30))) };
+		return read > 0 ? static_cast<std::size_t>(read) : 0;
+#else
+		while (true) {
+			const ssize_t bytes{ ::read(fileno(file), out, count) };
+			if (bytes >= 0)
+				return static_cast<std::size_t>(bytes);
+			if (errno != EINTR)
+				return 0;
+		}
+#endif
+	}
+}
+
+CommandReader::CommandReader(std::FILE* file, std::size_t bufferSize)
+	: m_file{ file }, m_buffer(std::max<std::size_t>(bufferSize, 16))
+{
+	m_pos = m_buffer.data();
+	m_end = m_pos;
+}
+
+std::unique_ptr<CommandReader> CommandReader::open(const std::filesystem::path& path) {
+	std::error_code error{};
+	if (!std::filesystem::is_regular_file(path, error))
+		return nullptr;
+
+	std::unique_ptr<CommandReader> reader{ new CommandReader{} };
+	reader->m_mapped = std::make_unique<MappedFile>(path);
+	//An empty file has no mapping, point at an empty string instead of nullptr so memchr etc. stay happy.
+	static constexpr char s_empty{};
+	reader->m_pos = reader->m_mapped->size() > 0 ? reader->m_mapped->data() : &s_empty;
+	reader->m_end = reader->m_pos + reader->m_mapped->size();
+	reader->m_atEnd = true;
+	return reader;
+}
+
+CommandReader& CommandReader::standardInput() {
+	static CommandReader s_reader{ stdin };
+	return s_reader;
+}
+
+bool CommandReader::refill() {
+	if (m_atEnd)
+		return false;
+
+	//Move the unread part to the front, and grow the buffer if the unread part fills it.
+	const std::size_t kept{ static_cast<std::size_t>(m_end - m_pos) };
+	std::memmove(m_buffer.data(), m_pos, kept);
+	if (kept == m_buffer.size())
+		m_buffer.resize(m_buffer.size() * 2);
+
+	const std::size_t read{ readSome(m_file, m_buffer.data() + kept, m_buffer.size() - kept) };
+	m_pos = m_buffer.data();
+	m_end = m_pos + kept + read;
+	if (read == 0)
+		m_atEnd = true;
+	return read > 0;
+}
+
+void CommandReader::bufferLine() {
+	std::size_t scanned{ 0 };
+	while (!std::memchr(m_pos + scanned, '\n', static_cast<std::size_t>(m_end - m_pos) - scanned)) {
+		scanned = static_cast<std::size_t>(m_end - m_pos);
+		if (!refill())
+			return;
+	}
+}
+
+bool CommandReader::skipWhitespace() {
+	while (true) {
+		while (m_pos < m_end && isSpace(*m_pos))
+			++m_pos;
+		if (m_pos < m_end) {
+			bufferLine();
+			return true;
+		}
+		if (!refill())
+			return false;
+	}
+}
+
+std::optional<std::string_view> CommandReader::word() {
+	if (!skipWhitespace())
+		return std::nullopt;
+
+	const char* const start{ m_pos };
+	while (m_pos < m_end && !isSpace(*m_pos))
+		++m_pos;
+	return std::string_view{ start, static_cast<std::size_t>(m_pos - start) };
+}
+
+std::optional<char> CommandReader::character() {
+	if (!skipWhitespace())
+		return std::nullopt;
+	return *m_pos++;
+}
+
+CommandReader::IntInput CommandReader::readInt(int low, int high) {
+	if (!skipWhitespace())
+		return { IntResult::end, 0 };
+
+	//std::cin >> int takes a leading + and from_chars doesn't.
+	const char* first{ m_pos };
+	if (*first == '+' && first + 1 < m_end && *(first + 1) != '-')
+		++first;
+
+	IntInput input{};
+	const auto [ptr, error] { std::from_chars(first, m_end, input.value) };
+	if (error != std::errc{})
+		input.result = IntResult::invalid; //not a number, or doesn't fit in an int(std::cin fails on both too)
+	else if (input.value < low || input.value > high)
+		input.result = IntResult::outOfRange;
+	else
+		input.result = IntResult::ok;
+
+	ignoreLine();
+	return input;
+}
+
+std::optional<std::string_view> CommandReader::line() {
+	if (m_pos >= m_end && !refill())
+		return std::nullopt;
+	bufferLine();
+
+	const auto* newline{ static_cast<const char*>(std::memchr(m_pos, '\n', static_cast<std::size_t>(m_end - m_pos))) };
+	const char* const start{ m_pos };
+	const char* end{ newline ? newline : m_end };
+	m_pos = newline ? newline + 1 : m_end;
+	if (end > start && *(end - 1) == '\r')
+		--end;
+	return std::string_view{ start, static_cast<std::size_t>(end - start) };
+}
+
+void CommandReader::ignoreLine() {
+	//No need to buffer the whole line just to skip it, so this never grows the buffer.
+	while (true) {
+		if (const auto* newline{ static_cast<const char*>(std::memchr(m_pos, '\n', static_cast<std::size_t>(m_end - m_pos))) }) {
+			m_pos = newline + 1;
+			return;
+		}
+		m_pos = m_end;
+		if (!refill())
+			return;
+	}
+}
+
+bool CommandReader::atEnd() {
+	return m_pos >= m_end && !refill();
+}
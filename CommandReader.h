@@ -0,0 +1,83 @@
+#ifndef COMMANDREADER_H
+#define COMMANDREADER_H
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.h"
+
+// Reads the commands that drive the games(getUserInt(), gameStart(), ...) from stdin or from a script file,
+// without going through std::cin.
+//
+// Input is either a mapped file(open()) or a FILE read in big chunks into one buffer(usually stdin). Words and lines
+// are handed out as string_views straight into the file or buffer, nothing is copied, and numbers are parsed with
+// std::from_chars. A view stays valid until the next call on the reader.
+//
+// The rules are the same as the std::cin versions: readInt() skips whitespace(newlines too), reads a number, and
+// then throws away the rest of the line whether the number was any good or not, like getUserInt() calling
+// ignoreLine(). Unlike std::cin, running out of input isn't an error state you have to clear: everything just
+// returns std::nullopt/end, so a script that ends early can't make a game loop spin forever.
+//
+// Don't mix a reader on stdin with std::cin, each keeps its own buffer.
+class CommandReader {
+public:
+	enum class IntResult {
+		ok,
+		invalid,	// not a number, or too big for an int
+		outOfRange,	// a number, but not in [low, high]
+		end,		// no more input
+	};
+
+	struct IntInput {
+		IntResult result{};
+		int value{};
+	};
+
+private:
+	const char* m_pos{};
+	const char* m_end{};
+	bool m_atEnd{ false };	// nothing left to read past m_end
+
+	std::FILE* m_file{};
+	std::vector<char> m_buffer{};
+	std::unique_ptr<MappedFile> m_mapped{};
+
+	CommandReader() = default;
+
+	// Reads more of m_file into the buffer, keeping [m_pos, m_end). Returns false at the end of the file.
+	bool refill();
+	// Makes sure the buffer holds the whole line starting at m_pos(or everything up to the end of the input).
+	void bufferLine();
+	// Skips spaces, tabs and newlines. Returns false if the input ran out first.
+	bool skipWhitespace();
+
+public:
+	// Reads file(which has to stay open) through a buffer of bufferSize bytes. Lines longer than the buffer grow it.
+	explicit CommandReader(std::FILE* file, std::size_t bufferSize = 1 << 16);
+
+	// Maps the whole file. Returns nullptr if it can't be opened.
+	static std::unique_ptr<CommandReader> open(const std::filesystem::path& path);
+
+	// The reader over stdin that getUserInt() and gameStart() use.
+	static CommandReader& standardInput();
+
+	// Next whitespace separated word, like std::cin >> std::string.
+	std::optional<std::string_view> word();
+	// Next non-whitespace character, like std::cin >> char.
+	std::optional<char> character();
+	// Next int, then skips the rest of the line. See IntResult.
+	IntInput readInt(int low, int high);
+	// The rest of the current line, without the '\n'(or "\r\n").
+	std::optional<std::string_view> line();
+	// Skips to the start of the next line, like ignoreLine().
+	void ignoreLine();
+
+	bool atEnd();
+};
+
+#endif
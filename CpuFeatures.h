@@ -0,0 +1,62 @@
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+// Asking the CPU what it can do while the program runs, so one .exe can use AVX2 where it's there and still run
+// on CPUs without it.
+//
+// The project builds for plain x64(SSE2), so AVX2 code has to be marked for the compiler and only called after
+// CpuFeatures::avx2() said yes:
+//
+//	#if defined(CPUFEATURES_AVX2)
+//	CPUFEATURES_TARGET_AVX2 void sumAvx2(...) { ... _mm256_... }
+//	#endif
+//	...
+//	if (CpuFeatures::avx2()) sumAvx2(...); else sumSse2(...);
+//
+// MSVC lets any function use AVX2 intrinsics, GCC/Clang need the target attribute on the function that does.
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPUFEATURES_AVX2 1 // AVX2 kernels can be compiled, whether they can run is up to avx2()
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CPUFEATURES_TARGET_AVX2
+#else
+#define CPUFEATURES_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace CpuFeatures
+{
+	// True if AVX2 instructions can be used: the CPU has them and the OS saves the 256 bit registers.
+	// Only asks the CPU the first time.
+	inline bool avx2()
+	{
+#if defined(__AVX2__)
+		return true; // built with /arch:AVX2 or -mavx2, the compiler is already using it everywhere
+#elif defined(CPUFEATURES_AVX2) && defined(_MSC_VER) && !defined(__clang__)
+		static const bool supported{ [] {
+			int info[4]{};
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+			__cpuid(info, 1);
+			const bool osxsave{ (info[2] & (1 << 27)) != 0 };
+			const bool avx{ (info[2] & (1 << 28)) != 0 };
+			// XCR0 bits 1 and 2: the OS saves the SSE and AVX registers on a thread switch.
+			if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+				return false;
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+		}() };
+		return supported;
+#elif defined(CPUFEATURES_AVX2)
+		static const bool supported{ __builtin_cpu_supports("avx2") != 0 };
+		return supported;
+#else
+		return false;
+#endif
+	}
+}
+
+#endif
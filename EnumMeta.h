@@ -0,0 +1,96 @@
+#ifndef ENUMMETA_H
+#define ENUMMETA_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "PerfectHash.h"
+
+// One place to describe an enum's names, instead of a switch for enum -> string, a loop for string -> enum
+// and a static_assert next to every name array(13.4, 16.9, 17.6).
+// Specialize EnumMeta::Traits for the enum with its names in enumerator order:
+//
+//	template <>
+//	struct EnumMeta::Traits<Color::Type>
+//	{
+//		static constexpr std::array<std::string_view, 3> names{ "black", "red", "blue" };
+//		static constexpr Color::Type end{ Color::max_colors };	// optional, checked against names.size()
+//		static constexpr std::string_view invalid{ "???" };		// optional, returned for out of range values
+//	};
+//
+// Then toString(), fromString(), count and values() work for it. toString() is an array index,
+// fromString() is a PerfectHash::Table built at compile time.
+namespace EnumMeta
+{
+	template <typename Enum>
+	struct Traits;
+
+	template <typename Enum>
+	inline constexpr std::size_t count{ Traits<Enum>::names.size() };
+
+	namespace Detail
+	{
+		template <typename Enum>
+		constexpr bool checkCount()
+		{
+			if constexpr (requires { Traits<Enum>::end; })
+				static_assert(static_cast<std::size_t>(Traits<Enum>::end) == count<Enum>, "EnumMeta: names doesn't have one entry per enumerator");
+			return true;
+		}
+
+		template <typename Enum>
+		constexpr std::string_view invalid()
+		{
+			if constexpr (requires { Traits<Enum>::invalid; })
+				return Traits<Enum>::invalid;
+			else
+				return "???";
+		}
+
+		// names with the invalid name tacked on the end, so toString() can clamp the index instead of branching.
+		template <typename Enum>
+		constexpr std::array<std::string_view, count<Enum> + 1> makeLookup()
+		{
+			static_assert(checkCount<Enum>());
+			std::array<std::string_view, count<Enum> + 1> lookup{};
+			for (std::size_t i{ 0 }; i < count<Enum>; ++i)
+				lookup[i] = Traits<Enum>::names[i];
+			lookup[count<Enum>] = invalid<Enum>();
+			return lookup;
+		}
+
+		template <typename Enum>
+		inline constexpr std::array lookup{ makeLookup<Enum>() };
+
+		template <typename Enum>
+		inline constexpr PerfectHash::Table<Enum, count<Enum>> table{ Traits<Enum>::names };
+	}
+
+	template <typename Enum>
+	constexpr std::string_view toString(Enum value)
+	{
+		// Anything out of range(including negative values, which wrap around to huge indices) gets the invalid name.
+		const auto index{ static_cast<std::size_t>(value) };
+		return Detail::lookup<Enum>[index < count<Enum> ? index : count<Enum>];
+	}
+
+	template <typename Enum>
+	constexpr std::optional<Enum> fromString(std::string_view name)
+	{
+		return Detail::table<Enum>.fromString(name);
+	}
+
+	// Every enumerator in order, for range-based for loops: for (auto color : EnumMeta::values<Color::Type>())
+	template <typename Enum>
+	constexpr std::array<Enum, count<Enum>> values()
+	{
+		std::array<Enum, count<Enum>> result{};
+		for (std::size_t i{ 0 }; i < count<Enum>; ++i)
+			result[i] = static_cast<Enum>(i);
+		return result;
+	}
+}
+
+#endif
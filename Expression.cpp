@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+#include "CpuFeatures.h"
+#include "Expression.h"
+
+// Same SSE2 check as InventoryAnalytics.cpp and PlayerIndex.cpp. SSE2 has no 32 bit multiply, so with SSE2 only
+// + and - get explicit vector loops, * is left to the compiler. If the CPU has AVX2(CpuFeatures::avx2()), all three
+// run 8 rows at a time instead.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EXPRESSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	using Op = Expression::Op;
+
+	// Wrapping +, - and *: done in unsigned, where overflow is defined, which is also what the vector instructions do.
+	int wrap(unsigned int value) { return static_cast<int>(value); }
+
+	int divide(int x, int y)
+	{
+		if (y == 0)
+			return 0;
+		if (y == -1)
+			return wrap(0u - static_cast<unsigned int>(x)); // INT_MIN / -1 doesn't fit
+		return x / y;
+	}
+
+	int remainder(int x, int y)
+	{
+		return y == 0 || y == -1 ? 0 : x % y;
+	}
+
+	int apply(Op op, int x, int y)
+	{
+		switch (op)
+		{
+		case Op::add:		return wrap(static_cast<unsigned int>(x) + static_cast<unsigned int>(y));
+		case Op::subtract:	return wrap(static_cast<unsigned int>(x) - static_cast<unsigned int>(y));
+		case Op::multiply:	return wrap(static_cast<unsigned int>(x) * static_cast<unsigned int>(y));
+		case Op::divide:	return divide(x, y);
+		case Op::remainder:	return remainder(x, y);
+		}
+		return x;
+	}
+
+	// One struct per vectorized op. scalar() is used for the rows left over after the last full vector, and for every
+	// row if there's no vector version.
+	struct Add
+	{
+		static int scalar(int x, int y) { return apply(Op::add, x, y); }
+#if defined(EXPRESSION_SSE2)
+		static __m128i sse2(__m128i x, __m128i y) { return _mm_add_epi32(x, y); }
+#endif
+#if defined(CPUFEATURES_AVX2)
+		CPUFEATURES_TARGET_AVX2 static __m256i avx2(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+#endif
+	};
+
+	struct Subtract
+	{
+		static int scalar(int x, int y) { return apply(Op::subtract, x, y); }
+#if defined(EXPRESSION_SSE2)
+		static __m128i sse2(__m128i x, __m128i y) { return _mm_sub_epi32(x, y); }
+#endif
+#if defined(CPUFEATURES_AVX2)
+		CPUFEATURES_TARGET_AVX2 static __m256i avx2(__m256i x, __m256i y) { return _mm256_sub_epi32(x, y); }
+#endif
+	};
+
+	struct Multiply
+	{
+		static int scalar(int x, int y) { return apply(Op::multiply, x, y); }
+#if defined(CPUFEATURES_AVX2)
+		CPUFEATURES_TARGET_AVX2 static __m256i avx2(__m256i x, __m256i y) { return _mm256_mullo_epi32(x, y); }
+#endif
+	};
+
+#if defined(EXPRESSION_SSE2)
+	template <typename Kernel>
+	concept Sse2 = requires(__m128i x) { Kernel::sse2(x, x); };
+
+	__m128i load(const int* in) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)); }
+	void store(int* out, __m128i value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value); }
+#endif
+
+#if defined(CPUFEATURES_AVX2)
+	CPUFEATURES_TARGET_AVX2 __m256i load8(const int* in) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)); }
+	CPUFEATURES_TARGET_AVX2 void store8(int* out, __m256i value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), value); }
+
+	// The AVX2 versions of runColumn() and runConstant() below, only called if the CPU has AVX2.
+	template <typename Kernel>
+	CPUFEATURES_TARGET_AVX2 void runColumnAvx2(int* values, const int* column, std::size_t count)
+	{
+		std::size_t i{ 0 };
+		for (; i + 8 <= count; i += 8)
+			store8(values + i, Kernel::avx2(load8(values + i), load8(column + i)));
+		for (; i < count; ++i)
+			values[i] = Kernel::scalar(values[i], column[i]);
+	}
+
+	template <typename Kernel>
+	CPUFEATURES_TARGET_AVX2 void runConstantAvx2(int* values, int constant, std::size_t count)
+	{
+		const __m256i right{ _mm256_set1_epi32(constant) };
+		std::size_t i{ 0 };
+		for (; i + 8 <= count; i += 8)
+			store8(values + i, Kernel::avx2(load8(values + i), right));
+		for (; i < count; ++i)
+			values[i] = Kernel::scalar(values[i], constant);
+	}
+#endif
+
+	// values[i] = values[i] op column[i]
+	template <typename Kernel>
+	void runColumn(int* values, const int* column, std::size_t count)
+	{
+#if defined(CPUFEATURES_AVX2)
+		if (CpuFeatures::avx2())
+			return runColumnAvx2<Kernel>(values, column, count);
+#endif
+		std::size_t i{ 0 };
+#if defined(EXPRESSION_SSE2)
+		if constexpr (Sse2<Kernel>)
+		{
+			for (; i + 4 <= count; i += 4)
+				store(values + i, Kernel::sse2(load(values + i), load(column + i)));
+		}
+#endif
+		for (; i < count; ++i)
+			values[i] = Kernel::scalar(values[i], column[i]);
+	}
+
+	// values[i] = values[i] op constant
+	template <typename Kernel>
+	void runConstant(int* values, int constant, std::size_t count)
+	{
+#if defined(CPUFEATURES_AVX2)
+		if (CpuFeatures::avx2())
+			return runConstantAvx2<Kernel>(values, constant, count);
+#endif
+		std::size_t i{ 0 };
+#if defined(EXPRESSION_SSE2)
+		if constexpr (Sse2<Kernel>)
+		{
+			const __m128i right{ _mm_set1_epi32(constant) };
+			for (; i + 4 <= count; i += 4)
+				store(values + i, Kernel::sse2(load(values + i), right));
+		}
+#endif
+		for (; i < count; ++i)
+			values[i] = Kernel::scalar(values[i], constant);
+	}
+
+	void divideByConstant(Op op, int* values, int constant, std::size_t count)
+	{
+		// Check the special divisors once instead of once per row.
+		if (constant == 0 || (constant == -1 && op == Op::remainder))
+			std::fill(values, values + count, 0);
+		else if (constant == -1)
+			runConstant<Multiply>(values, -1, count);
+		else if (op == Op::divide)
+		{
+			for (std::size_t i{ 0 }; i < count; ++i)
+				values[i] /= constant;
+		}
+		else
+		{
+			for (std::size_t i{ 0 }; i < count; ++i)
+				values[i] %= constant;
+		}
+	}
+}
+
+std::optional<Expression::Op> Expression::toOp(char op)
+{
+	switch (op)
+	{
+	case '+': return Op::add;
+	case '-': return Op::subtract;
+	case '*': return Op::multiply;
+	case '/': return Op::divide;
+	case '%': return Op::remainder;
+	default: return std::nullopt;
+	}
+}
+
+Expression::Expression(Operand first)
+	: m_first{ first }
+{
+	use(first);
+}
+
+void Expression::use(Operand operand)
+{
+	if (operand.isColumn)
+		m_columns = std::max(m_columns, operand.value + 1);
+}
+
+Expression& Expression::then(Op op, Operand operand)
+{
+	use(operand);
+	if (!operand.isColumn)
+	{
+		// x - c is x + (-c), which then folds with the adds around it. Wrapping makes this right for INT_MIN too.
+		if (op == Op::subtract)
+		{
+			op = Op::add;
+			operand.value = apply(Op::subtract, 0, operand.value);
+		}
+
+		if (m_steps.empty() && !m_first.isColumn)
+		{
+			m_first.value = apply(op, m_first.value, operand.value);
+			return *this;
+		}
+		if (!m_steps.empty() && !m_steps.back().operand.isColumn && m_steps.back().op == op && (op == Op::add || op == Op::multiply))
+		{
+			m_steps.back().operand.value = apply(op, m_steps.back().operand.value, operand.value);
+			return *this;
+		}
+	}
+	m_steps.push_back(Step{ op, operand });
+	return *this;
+}
+
+std::optional<Expression> Expression::compile(std::string_view source)
+{
+	std::size_t pos{ 0 };
+	auto skipSpaces{ [&] {
+		while (pos < source.size() && std::isspace(static_cast<unsigned char>(source[pos])))
+			++pos;
+	} };
+	auto operand{ [&]() -> std::optional<Operand> {
+		skipSpaces();
+		if (pos < source.size() && source[pos] >= 'a' && source[pos] <= 'z')
+			return column(source[pos++] - 'a');
+
+		int value{};
+		const auto [end, error] { std::from_chars(source.data() + pos, source.data() + source.size(), value) };
+		if (error != std::errc{})
+			return std::nullopt;
+		pos = static_cast<std::size_t>(end - source.data());
+		return constant(value);
+	} };
+
+	const std::optional<Operand> first{ operand() };
+	if (!first)
+		return std::nullopt;
+
+	Expression expression{ *first };
+	for (skipSpaces(); pos < source.size(); skipSpaces())
+	{
+		const std::optional<Op> op{ toOp(source[pos++]) };
+		const std::optional<Operand> right{ operand() };
+		if (!op || !right)
+			return std::nullopt;
+		expression.then(*op, *right);
+	}
+	return expression;
+}
+
+int Expression::evaluate(std::span<const int> row) const
+{
+	auto value{ [&](Operand operand) { return operand.isColumn ? row[static_cast<std::size_t>(operand.value)] : operand.value; } };
+
+	int result{ value(m_first) };
+	for (const Step& step : m_steps)
+		result = apply(step.op, result, value(step.operand));
+	return result;
+}
+
+void Expression::evaluateBlock(std::span<const std::span<const int>> columns, std::size_t start, int* out, std::size_t count) const
+{
+	// The block of out holds the running value of every row, so there's no scratch space to keep.
+	if (m_first.isColumn)
+		std::copy_n(columns[static_cast<std::size_t>(m_first.value)].data() + start, count, out);
+	else
+		std::fill_n(out, count, m_first.value);
+
+	for (const Step& step : m_steps)
+	{
+		if (step.operand.isColumn)
+		{
+			const int* column{ columns[static_cast<std::size_t>(step.operand.value)].data() + start };
+			switch (step.op)
+			{
+			case Op::add:		runColumn<Add>(out, column, count); break;
+			case Op::subtract:	runColumn<Subtract>(out, column, count); break;
+			case Op::multiply:	runColumn<Multiply>(out, column, count); break;
+			case Op::divide:
+				for (std::size_t i{ 0 }; i < count; ++i)
+					out[i] = divide(out[i], column[i]);
+				break;
+			case Op::remainder:
+				for (std::size_t i{ 0 }; i < count; ++i)
+					out[i] = remainder(out[i], column[i]);
+				break;
+			}
+		}
+		else
+		{
+			const int constant{ step.operand.value };
+			switch (step.op)
+			{
+			case Op::add:		runConstant<Add>(out, constant, count); break;
+			case Op::subtract:	runConstant<Subtract>(out, constant, count); break;
+			case Op::multiply:	runConstant<Multiply>(out, constant, count); break;
+			case Op::divide:
+			case Op::remainder:	divideByConstant(step.op, out, constant, count); break;
+			}
+		}
+	}
+}
+
+bool Expression::evaluate(std::span<const std::span<const int>> columns, std::span<int> out, int threadCount) const
+{
+	if (columns.size() < static_cast<std::size_t>(m_columns))
+		return false;
+	for (int i{ 0 }; i < m_columns; ++i)
+	{
+		if (columns[static_cast<std::size_t>(i)].size() < out.size())
+			return false;
+	}
+
+	// Threads take 16 blocks at a time, a single block is only a few microseconds of work.
+	constexpr std::size_t batchSize{ blockSize * 16 };
+	const std::size_t batches{ (out.size() + batchSize - 1) / batchSize };
+	Parallel::forEachIndex(batches, threadCount, [&](std::size_t batch, int) {
+		const std::size_t end{ std::min(out.size(), (batch + 1) * batchSize) };
+		for (std::size_t start{ batch * batchSize }; start < end; start += blockSize)
+			evaluateBlock(columns, start, out.data() + start, std::min(blockSize, end - start));
+	});
+	return true;
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+
+#include "FizzBuzz.h"
+
+namespace
+{
+	// Lines are copied in fixed size blocks so the copy doesn't depend on the line length.
+	// Both the counter and the word table keep this much readable space past their end for that.
+	constexpr std::size_t copyBlock = 32;
+
+	// The number being printed, kept as ASCII digits. Going from n to n + 1 only touches the last digit
+	// (and the digits it carries into, 1 time in 10), which is much cheaper than converting n from scratch.
+	class DecimalCounter
+	{
+	private:
+		static constexpr int maxDigits = 20;
+		char m_digits[maxDigits + copyBlock]{};
+		int m_start{ maxDigits }; // index of the first digit
+
+	public:
+		explicit DecimalCounter(long long value)
+		{
+			do
+			{
+				m_digits[--m_start] = static_cast<char>('0' + value % 10);
+				value /= 10;
+			} while (value > 0);
+		}
+
+		void increment()
+		{
+			int i{ maxDigits - 1 };
+			while (i >= m_start && m_digits[i] == '9')
+				m_digits[i--] = '0';
+
+			if (i >= m_start)
+				++m_digits[i];
+			else
+				m_digits[--m_start] = '1'; // 999 -> 1000
+		}
+
+		const char* data() const { return m_digits + m_start; }
+		std::size_t size() const { return static_cast<std::size_t>(maxDigits - m_start); }
+	};
+}
+
+namespace FizzBuzz
+{
+	Engine::Engine(const std::vector<Rule>& rules)
+	{
+		for (const Rule& rule : rules)
+		{
+			assert(rule.divisor > 0);
+			m_period = std::lcm(m_period, rule.divisor);
+			assert(m_period <= maxPeriod && "divisors are too big to build a pattern table for");
+		}
+
+		// Build the line for each position in the period. Position i stands for every number n with n % period == i.
+		m_pattern.resize(m_period);
+		for (int i{ 0 }; i < m_period; ++i)
+		{
+			Line& line{ m_pattern[i] };
+			line.offset = static_cast<std::uint32_t>(m_words.size());
+			for (const Rule& rule : rules)
+			{
+				if (i % rule.divisor == 0)
+					m_words += rule.word;
+			}
+			line.length = static_cast<std::uint32_t>(m_words.size() - line.offset);
+			m_longestLine = std::max<std::size_t>(m_longestLine, line.length);
+		}
+
+		m_words.append(copyBlock, '\0'); // padding for the block copies in run()
+	}
+
+	void Engine::run(long long first, long long last, OutputBuffer& out) const
+	{
+		assert(first >= 1);
+
+		// Space for the longest word or a 20 digit number, plus the newline. At least a full copy block either way.
+		const std::size_t lineBytes{ std::max<std::size_t>(std::max<std::size_t>(m_longestLine, 20) + 1, copyBlock) };
+		// Reserve room for a batch of lines at a time instead of checking before every line.
+		const long long batchLines{ static_cast<long long>(std::clamp<std::size_t>(out.capacity() / lineBytes, 1, 4096)) };
+		const char* const words{ m_words.data() };
+
+		DecimalCounter number{ first };
+		auto position{ static_cast<int>(first % m_period) }; // the only % in here
+
+		for (long long batchStart{ first }; batchStart <= last; batchStart += batchLines)
+		{
+			const long long batchEnd{ std::min(last, batchStart + batchLines - 1) };
+			char* const begin{ out.reserve(static_cast<std::size_t>(batchEnd - batchStart + 1) * lineBytes) };
+			char* dest{ begin };
+
+			for (long long n{ batchStart }; n <= batchEnd; ++n)
+			{
+				const Line line{ m_pattern[position] };
+
+				// Pick the source without branching on which kind of line it is.
+				const bool isNumber{ line.length == 0 };
+				const char* source{ isNumber ? number.data() : words + line.offset };
+				const std::size_t length{ isNumber ? number.size() : line.length };
+
+				// Copy a whole block(a fixed size copy is a couple of vector moves), the extra bytes just get overwritten.
+				// Words longer than a block fall back to a normal copy.
+				if (length < copyBlock)
+					std::memcpy(dest, source, copyBlock);
+				else
+					std::memcpy(dest, source, length);
+				dest[length] = '\n';
+				dest += length + 1;
+
+				number.increment();
+				if (++position == m_period)
+					position = 0;
+			}
+
+			out.commit(static_cast<std::size_t>(dest - begin));
+		}
+	}
+
+	const std::vector<Rule>& fizzbuzzRules()
+	{
+		static const std::vector<Rule> s_rules{ { 3, "fizz" }, { 5, "buzz" } };
+		return s_rules;
+	}
+
+	const std::vector<Rule>& fizzbuzzpopRules()
+	{
+		static const std::vector<Rule> s_rules{ { 3, "fizz" }, { 5, "buzz" }, { 7, "pop" } };
+		return s_rules;
+	}
+}
@@ -0,0 +1,53 @@
+#ifndef FIZZBUZZ_H
+#define FIZZBUZZ_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "OutputBuffer.h"
+
+// General version of fizzbuzz()/fizzbuzzpop() (8.10 Q4/Q5) that works with any table of divisors and words.
+// A number prints every word whose divisor divides it(in table order), or the number itself if none do.
+// The pattern of words repeats every lcm(divisors) numbers, so the Engine works out that pattern once in the
+// constructor. Printing then just steps through the pattern table, no % per number.
+namespace FizzBuzz
+{
+	struct Rule
+	{
+		int divisor{};
+		std::string_view word{};
+	};
+
+	class Engine
+	{
+	private:
+		struct Line
+		{
+			std::uint32_t offset{}; // into m_words
+			std::uint32_t length{}; // 0 means print the number instead
+		};
+
+		int m_period{ 1 };
+		std::string m_words{};
+		std::vector<Line> m_pattern{};
+		std::size_t m_longestLine{ 0 };
+
+	public:
+		// The lcm of the divisors has to stay small enough to keep a table for(maxPeriod entries).
+		static constexpr int maxPeriod = 1 << 20;
+
+		explicit Engine(const std::vector<Rule>& rules);
+
+		// Prints one line for each number in [first, last]. first must be >= 1.
+		void run(long long first, long long last, OutputBuffer& out) const;
+
+		int period() const { return m_period; }
+	};
+
+	const std::vector<Rule>& fizzbuzzRules();    // 3 fizz, 5 buzz
+	const std::vector<Rule>& fizzbuzzpopRules(); // 3 fizz, 5 buzz, 7 pop
+}
+
+#endif
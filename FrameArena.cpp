@@ -0,0 +1,61 @@
+#include <algorithm>
+
+#include "FrameArena.h"
+
+FrameArena::FrameArena(std::size_t initialBlockSize)
+	: m_nextBlockSize{ std::max<std::size_t>(initialBlockSize, 256) }
+{ }
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+	if (m_block < m_blocks.size())
+	{
+		Block& block{ m_blocks[m_block] };
+		void* start{ block.memory.get() + m_offset };
+		std::size_t space{ block.size - m_offset };
+		if (std::align(alignment, bytes, start, space))
+		{
+			m_offset = block.size - space + bytes;
+			return start;
+		}
+	}
+	return allocateSlow(bytes, alignment);
+}
+
+void* FrameArena::allocateSlow(std::size_t bytes, std::size_t alignment)
+{
+	// Move on to the next kept block that is big enough, or make a new one.
+	// Blocks too small for this request are skipped for the rest of the frame.
+	const std::size_t needed{ bytes + alignment };
+	if (!m_blocks.empty())
+		++m_block;
+	for (; m_block < m_blocks.size(); ++m_block)
+	{
+		if (m_blocks[m_block].size >= needed)
+			break;
+	}
+
+	if (m_block == m_blocks.size())
+	{
+		// Each new block is double the last, so the number of blocks stays small.
+		const std::size_t size{ std::max(m_nextBlockSize, needed) };
+		m_nextBlockSize = size * 2;
+		m_blocks.push_back(Block{ std::make_unique<std::byte[]>(size), size });
+	}
+
+	m_offset = 0;
+	Block& block{ m_blocks[m_block] };
+	void* start{ block.memory.get() };
+	std::size_t space{ block.size };
+	std::align(alignment, bytes, start, space);
+	m_offset = block.size - space + bytes;
+	return start;
+}
+
+std::size_t FrameArena::capacity() const
+{
+	std::size_t total{ 0 };
+	for (const Block& block : m_blocks)
+		total += block.size;
+	return total;
+}
@@ -0,0 +1,54 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// A memory resource for objects that all die at the same time, like everything created for one encounter.
+// Allocating just bumps a pointer forward, deallocating does nothing, and reset() frees everything at once
+// by moving the pointer back to the start. The blocks are kept, so after the first encounter the arena
+// doesn't go to the heap at all.
+//
+// Use it through std::pmr: std::pmr::vector<Player> players{ &arena };
+// Everything allocated from the arena has to be destroyed(or forgotten) before reset() is called.
+class FrameArena : public std::pmr::memory_resource
+{
+private:
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> memory{};
+		std::size_t size{};
+	};
+
+	std::vector<Block> m_blocks{};
+	std::size_t m_block{ 0 };   // block currently being allocated from
+	std::size_t m_offset{ 0 };  // bytes used in that block
+	std::size_t m_nextBlockSize{};
+
+	void* allocateSlow(std::size_t bytes, std::size_t alignment);
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void*, std::size_t, std::size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+	explicit FrameArena(std::size_t initialBlockSize = 64 * 1024);
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	// Frees everything allocated since the last reset. O(1), the memory is kept for next time.
+	void reset()
+	{
+		m_block = 0;
+		m_offset = 0;
+	}
+
+	// Bytes of memory the arena is holding on to.
+	std::size_t capacity() const;
+};
+
+#endif
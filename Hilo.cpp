@@ -0,0 +1,24 @@
+#include <algorithm>
+
+#include "Hilo.h"
+
+namespace Hilo
+{
+	double Report::averageGuesses() const
+	{
+		std::uint64_t guesses{ 0 };
+		for (std::size_t n{ 1 }; n < winsAfter.size(); ++n)
+			guesses += winsAfter[n] * n;
+		return wins == 0 ? 0.0 : static_cast<double>(guesses) / static_cast<double>(wins);
+	}
+
+	void Report::add(const Report& other)
+	{
+		games += other.games;
+		wins += other.wins;
+		if (winsAfter.size() < other.winsAfter.size())
+			winsAfter.resize(other.winsAfter.size(), 0);
+		for (std::size_t n{ 0 }; n < other.winsAfter.size(); ++n)
+			winsAfter[n] += other.winsAfter[n];
+	}
+}
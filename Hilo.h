@@ -0,0 +1,134 @@
+#ifndef HILO_H
+#define HILO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Combat.h"
+#include "Parallel.h"
+
+// The 8.x/9.x hilo() guessing game without a player: a strategy makes the guesses, and runMany() plays millions of
+// games on several threads to see how well it does. No std::cin, no std::cout.
+//
+// A strategy is anything callable as int(int low, int high, Rng& rng). low and high are what the game has told it so
+// far: after "too low" the next low is guess + 1, after "too high" the next high is guess - 1, so the number is always
+// in [low, high]. It returns the next guess.
+//
+// Like Combat::runMany(), every game gets its own generator seeded from (seed, game index), so the Report doesn't
+// depend on how many threads played the games. Each thread gets its own copy of the strategy and its own Report,
+// the Reports are added up at the end.
+namespace Hilo
+{
+	using Rng = Combat::Rng;
+
+	// Same defaults as hiloStart() suggests: 1 to 100 in 7 guesses.
+	struct Config
+	{
+		int low{ 1 };
+		int high{ 100 };
+		int guesses{ 7 };
+	};
+
+	// Guesses the middle of what's left. Always wins if 2^guesses - 1 >= high - low + 1.
+	struct BinarySearch
+	{
+		int operator()(int low, int high, Rng&) const { return low + (high - low) / 2; }
+	};
+
+	// Any number that could still be right.
+	struct RandomGuess
+	{
+		int operator()(int low, int high, Rng& rng) const { return rng.get(low, high); }
+	};
+
+	// Guesses towardHigh of the way from low to high. 0.5 is BinarySearch, 0 counts up one at a time.
+	struct Biased
+	{
+		double towardHigh{ 0.25 };
+
+		int operator()(int low, int high, Rng&) const
+		{
+			return low + static_cast<int>(static_cast<double>(high - low) * towardHigh);
+		}
+	};
+
+	struct Report
+	{
+		std::uint64_t games{ 0 };
+		std::uint64_t wins{ 0 };
+		// winsAfter[n] is how many games were won with guess n(1 to Config::guesses). winsAfter[0] is unused.
+		// Lost games used every guess.
+		std::vector<std::uint64_t> winsAfter{};
+
+		double winRate() const { return games == 0 ? 0.0 : static_cast<double>(wins) / static_cast<double>(games); }
+		// Average guesses over the games that were won.
+		double averageGuesses() const;
+
+		void add(const Report& other);
+	};
+
+	// Plays one game against rng. Returns the guess number it was won on, or 0 if it was lost.
+	template <typename Strategy>
+	int play(const Config& config, Strategy& strategy, Rng& rng)
+	{
+		const int number{ rng.get(config.low, config.high) };
+		int low{ config.low };
+		int high{ config.high };
+		for (int guess{ 1 }; guess <= config.guesses; ++guess)
+		{
+			const int input{ strategy(low, high, rng) };
+			if (input == number)
+				return guess;
+			// A guess outside [low, high] tells the strategy nothing new.
+			if (input < number && input >= low)
+				low = input + 1;
+			else if (input > number && input <= high)
+				high = input - 1;
+		}
+		return 0;
+	}
+
+	// Plays games [0, count) on up to threadCount threads. config.low has to be <= config.high.
+	template <typename Strategy>
+	Report runMany(const Config& config, const Strategy& strategy, std::size_t count, std::uint64_t seed,
+		int threadCount = Parallel::defaultThreadCount())
+	{
+		if (threadCount < 1)
+			threadCount = 1;
+
+		struct alignas(64) PerThread // own cache line, threads only ever write their own
+		{
+			Strategy strategy;
+			Report report{};
+		};
+		std::vector<PerThread> perThread(static_cast<std::size_t>(threadCount), PerThread{ strategy });
+		for (PerThread& thread : perThread)
+			thread.report.winsAfter.assign(static_cast<std::size_t>(config.guesses > 0 ? config.guesses + 1 : 1), 0);
+
+		// Games are handed out in chunks like Combat::runMany(), one game is far too little work to share a counter over.
+		constexpr std::size_t chunkSize{ 4096 };
+		const std::size_t chunks{ (count + chunkSize - 1) / chunkSize };
+		Parallel::forEachIndex(chunks, threadCount, [&](std::size_t chunk, int threadIndex) {
+			PerThread& thread{ perThread[static_cast<std::size_t>(threadIndex)] };
+			const std::size_t end{ (chunk + 1) * chunkSize < count ? (chunk + 1) * chunkSize : count };
+			for (std::size_t i{ chunk * chunkSize }; i < end; ++i)
+			{
+				Rng rng{ Rng{ seed ^ (i * 0xD1B54A32D192ED03ull) }.next() };
+				const int wonOn{ play(config, thread.strategy, rng) };
+				++thread.report.winsAfter[static_cast<std::size_t>(wonOn)];
+			}
+			thread.report.games += end - chunk * chunkSize;
+		});
+
+		Report total{ perThread[0].report };
+		for (std::size_t i{ 1 }; i < perThread.size(); ++i)
+			total.add(perThread[i].report);
+		// Lost games were counted in winsAfter[0] above, move them out.
+		total.wins = total.games - total.winsAfter[0];
+		total.winsAfter[0] = 0;
+		return total;
+	}
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include <algorithm>
+
+#include "CpuFeatures.h"
+#include "InventoryAnalytics.h"
+
+namespace
+{
+	std::size_t partitionCount(std::size_t players)
+	{
+		return (players + InventoryAnalytics::partitionSize - 1) / InventoryAnalytics::partitionSize;
+	}
+
+	std::uint8_t clampCount(int count)
+	{
+		return static_cast<std::uint8_t>(std::clamp(count, 0, 255));
+	}
+
+#if defined(CPUFEATURES_AVX2)
+	// Same idea as the SSE2 byte sum in PackedInventory.cpp, 32 bytes at a time.
+	CPUFEATURES_TARGET_AVX2 std::uint64_t sumColumnAvx2(std::span<const std::uint8_t> column)
+	{
+		const __m256i zero{ _mm256_setzero_si256() };
+		__m256i totals{ _mm256_setzero_si256() };
+		std::size_t i{ 0 };
+		for (; i + 32 <= column.size(); i += 32)
+		{
+			const __m256i chunk{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column.data() + i)) };
+			totals = _mm256_add_epi64(totals, _mm256_sad_epu8(chunk, zero));
+		}
+		std::uint64_t lanes[4]{};
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), totals);
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3] + PackedInventoryKernels::sumBytes(column.data() + i, column.size() - i);
+	}
+#endif
+}
+
+InventoryColumns::InventoryColumns(int itemTypes)
+	: m_columns(static_cast<std::size_t>(itemTypes > 0 ? itemTypes : 0))
+{ }
+
+void InventoryColumns::reserve(std::size_t players)
+{
+	for (auto& column : m_columns)
+		column.reserve(players);
+}
+
+std::size_t InventoryColumns::addPlayer(std::span<const int> counts)
+{
+	for (std::size_t item{ 0 }; item < m_columns.size(); ++item)
+		m_columns[item].push_back(item < counts.size() ? clampCount(counts[item]) : 0);
+	return m_players++;
+}
+
+void InventoryColumns::set(std::size_t player, int item, int count)
+{
+	m_columns[item][player] = clampCount(count);
+}
+
+namespace InventoryAnalytics
+{
+	std::uint64_t sumColumn(std::span<const std::uint8_t> column)
+	{
+#if defined(CPUFEATURES_AVX2)
+		if (CpuFeatures::avx2())
+			return sumColumnAvx2(column);
+#endif
+		return PackedInventoryKernels::sumBytes(column.data(), column.size());
+	}
+
+	std::vector<std::uint64_t> itemTotals(const InventoryColumns& inventories, int threadCount)
+	{
+		const std::size_t partitions{ partitionCount(inventories.players()) };
+		const auto items{ static_cast<std::size_t>(inventories.itemTypes()) };
+
+		// One partial sum per (item, partition), added up at the end so nobody has to share a counter.
+		std::vector<std::uint64_t> partials(items * partitions);
+		Parallel::forEachIndex(items * partitions, threadCount, [&](std::size_t index, int) {
+			const std::size_t item{ index / partitions };
+			const std::size_t start{ (index % partitions) * partitionSize };
+			const std::span<const std::uint8_t> column{ inventories.column(static_cast<int>(item)) };
+			partials[index] = sumColumn(column.subspan(start, std::min(partitionSize, column.size() - start)));
+		});
+
+		std::vector<std::uint64_t> totals(items);
+		for (std::size_t index{ 0 }; index < partials.size(); ++index)
+			totals[index / partitions] += partials[index];
+		return totals;
+	}
+
+	std::uint64_t total(const InventoryColumns& inventories, int threadCount)
+	{
+		std::uint64_t sum{ 0 };
+		for (const std::uint64_t itemTotal : itemTotals(inventories, threadCount))
+			sum += itemTotal;
+		return sum;
+	}
+
+	void playerTotals(const InventoryColumns& inventories, std::span<std::uint32_t> totals, int threadCount)
+	{
+		Parallel::forEachIndex(partitionCount(inventories.players()), threadCount, [&](std::size_t partition, int) {
+			const std::size_t start{ partition * partitionSize };
+			const std::size_t count{ std::min(partitionSize, inventories.players() - start) };
+			std::uint32_t* out{ totals.data() + start };
+
+			// Column at a time: each inner loop is a straight add of two arrays, which the compiler vectorizes.
+			std::fill(out, out + count, 0u);
+			for (int item{ 0 }; item < inventories.itemTypes(); ++item)
+			{
+				const std::uint8_t* column{ inventories.column(item).data() + start };
+				for (std::size_t i{ 0 }; i < count; ++i)
+					out[i] += column[i];
+			}
+		});
+	}
+
+	std::array<std::uint64_t, 256> histogram(const InventoryColumns& inventories, int item, int threadCount)
+	{
+		const std::span<const std::uint8_t> column{ inventories.column(item) };
+		const std::size_t partitions{ partitionCount(column.size()) };
+		std::vector<std::array<std::uint32_t, 256>> partials(partitions);
+
+		Parallel::forEachIndex(partitions, threadCount, [&](std::size_t partition, int) {
+			const std::size_t start{ partition * partitionSize };
+			const std::size_t end{ std::min(start + partitionSize, column.size()) };
+
+			// Four histograms, so runs of equal counts don't make every increment wait for the last one to the same bin.
+			std::array<std::array<std::uint32_t, 256>, 4> bins{};
+			std::size_t i{ start };
+			for (; i + 4 <= end; i += 4)
+			{
+				++bins[0][column[i]];
+				++bins[1][column[i + 1]];
+				++bins[2][column[i + 2]];
+				++bins[3][column[i + 3]];
+			}
+			for (; i < end; ++i)
+				++bins[0][column[i]];
+
+			for (std::size_t value{ 0 }; value < 256; ++value)
+				partials[partition][value] = bins[0][value] + bins[1][value] + bins[2][value] + bins[3][value];
+		});
+
+		std::array<std::uint64_t, 256> result{};
+		for (const auto& partial : partials)
+		{
+			for (std::size_t value{ 0 }; value < 256; ++value)
+				result[value] += partial[value];
+		}
+		return result;
+	}
+
+	std::vector<std::uint32_t> topK(const InventoryColumns& inventories, int item, std::size_t k, int threadCount)
+	{
+		const std::span<const std::uint8_t> column{ inventories.column(item) };
+		k = std::min(k, column.size());
+		if (k == 0)
+			return {};
+
+		// The histogram tells us the smallest count that still makes the top k(threshold), and how many players
+		// at exactly that count fit in. Then one pass picks them out, no sorting of millions of players needed.
+		const std::array<std::uint64_t, 256> counts{ histogram(inventories, item, threadCount) };
+		int threshold{ 255 };
+		std::uint64_t above{ 0 };
+		while (above + counts[threshold] < k)
+			above += counts[threshold--];
+		std::uint64_t atThresholdWanted{ k - above };
+
+		std::vector<std::uint32_t> result{};
+		result.reserve(k);
+		for (std::size_t player{ 0 }; player < column.size() && result.size() < k; ++player)
+		{
+			if (column[player] > threshold)
+				result.push_back(static_cast<std::uint32_t>(player));
+			else if (column[player] == threshold && atThresholdWanted > 0)
+			{
+				result.push_back(static_cast<std::uint32_t>(player));
+				--atThresholdWanted;
+			}
+		}
+
+		// Players were added in index order, so a stable sort by count keeps ties in index order.
+		std::stable_sort(result.begin(), result.end(), [&](std::uint32_t a, std::uint32_t b) {
+			return column[a] > column[b];
+		});
+		return result;
+	}
+}
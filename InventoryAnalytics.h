@@ -0,0 +1,76 @@
+#ifndef INVENTORYANALYTICS_H
+#define INVENTORYANALYTICS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "PackedInventory.h"
+#include "Parallel.h"
+
+// Inventories for millions of players stored by item instead of by player: one column per item type
+// (Items::Types, Potion::Type, ...), with one byte per player in each column. Counts above 255 are clamped,
+// same as a PotionInventory slot.
+// Questions like "how many arrows are there in total" then only read the arrow column, start to end,
+// which is about as fast as memory can go, instead of visiting every player's inventory.
+class InventoryColumns
+{
+private:
+	std::vector<std::vector<std::uint8_t>> m_columns{};
+	std::size_t m_players{ 0 };
+
+public:
+	explicit InventoryColumns(int itemTypes);
+
+	void reserve(std::size_t players);
+
+	// counts[i] is the count of item i. Missing items are 0, extra ones are ignored. Returns the new player's index.
+	std::size_t addPlayer(std::span<const int> counts);
+
+	template <int... Bits>
+	std::size_t addPlayer(const PackedInventory<Bits...>& inventory)
+	{
+		std::array<int, PackedInventory<Bits...>::itemCount> counts{};
+		for (int item{ 0 }; item < PackedInventory<Bits...>::itemCount; ++item)
+			counts[item] = inventory.count(item);
+		return addPlayer(counts);
+	}
+
+	void set(std::size_t player, int item, int count);
+	int count(std::size_t player, int item) const { return m_columns[item][player]; }
+
+	std::size_t players() const { return m_players; }
+	int itemTypes() const { return static_cast<int>(m_columns.size()); }
+	std::span<const std::uint8_t> column(int item) const { return m_columns[item]; }
+};
+
+// Reports over InventoryColumns. Each one splits the players into partitions, works on the partitions on
+// threadCount threads, then combines the partial results. Column sums use AVX2 if the CPU running the program has it
+// (see CpuFeatures.h), and SSE2 otherwise.
+namespace InventoryAnalytics
+{
+	// Players per partition. Big enough that threads don't spend their time grabbing partitions.
+	inline constexpr std::size_t partitionSize = 1 << 16;
+
+	// Sum of one column.
+	std::uint64_t sumColumn(std::span<const std::uint8_t> column);
+
+	// Total number of each item across all players.
+	std::vector<std::uint64_t> itemTotals(const InventoryColumns& inventories, int threadCount = Parallel::defaultThreadCount());
+
+	// Total number of items across all players.
+	std::uint64_t total(const InventoryColumns& inventories, int threadCount = Parallel::defaultThreadCount());
+
+	// countInventory() for every player at once: totals[p] is player p's item count. totals must be players() long.
+	void playerTotals(const InventoryColumns& inventories, std::span<std::uint32_t> totals, int threadCount = Parallel::defaultThreadCount());
+
+	// histogram[c] is how many players have exactly c of the item.
+	std::array<std::uint64_t, 256> histogram(const InventoryColumns& inventories, int item, int threadCount = Parallel::defaultThreadCount());
+
+	// The k players holding the most of the item, most first. Ties go to the lower player index.
+	std::vector<std::uint32_t> topK(const InventoryColumns& inventories, int item, std::size_t k, int threadCount = Parallel::defaultThreadCount());
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "Items.h"
+#include "OutputBuffer.h"
+
+namespace {
+	constexpr std::string_view youHave{ "You have " };
+	constexpr std::string_view inYourInventory{ " in your inventory.\n" };
+	constexpr std::size_t maxDigits{ 11 }; //"-2147483648"
+
+	constexpr std::size_t longestName() {
+		std::size_t longest{ 0 };
+		for (std::size_t i{ 0 }; i < Items::max_value; ++i)
+			longest = std::max({ longest, EnumMeta::Traits<Items::Types>::names[i].size(), Items::pluralNames[i].size() });
+		return longest;
+	}
+
+	//Most bytes one line can take, and all the lines of one inventory.
+	constexpr std::size_t maxLineSize{ youHave.size() + maxDigits + 1 + longestName() + inYourInventory.size() };
+	constexpr std::size_t maxSpecificsSize{ maxLineSize * Items::max_value };
+
+	void copy(char*& out, std::string_view text) {
+		std::memcpy(out, text.data(), text.size());
+		out += text.size();
+	}
+
+	//Writes the lines for counts at out, which needs room for maxSpecificsSize bytes. Returns the end of what it wrote.
+	char* renderSpecifics(char* out, std::span<const int> counts) {
+		const std::size_t items{ std::min(counts.size(), static_cast<std::size_t>(Items::max_value)) };
+		for (std::size_t i{ 0 }; i < items; ++i) {
+			copy(out, youHave);
+			out = std::to_chars(out, out + maxDigits, counts[i]).ptr;
+			*out++ = ' ';
+			copy(out, counts[i] == 1 ? EnumMeta::toString(static_cast<Items::Types>(i)) : Items::pluralNames[i]);
+			copy(out, inYourInventory);
+		}
+		return out;
+	}
+}
+
+namespace Items {
+	void printSpecifics(OutputBuffer& out, std::span<const int> counts) {
+		//Reserve room for every line at once, then fill them in without any more checks.
+		char* const start{ out.reserve(maxSpecificsSize) };
+		out.commit(static_cast<std::size_t>(renderSpecifics(start, counts) - start));
+	}
+
+	void printSpecifics(std::span<const int> counts, std::FILE* file) {
+		//One inventory is at most a few hundred bytes, a buffer on the stack is plenty.
+		std::array<char, maxSpecificsSize> lines{};
+		const char* const end{ renderSpecifics(lines.data(), counts) };
+		std::fwrite(lines.data(), 1, static_cast<std::size_t>(end - lines.data()), file);
+	}
+
+	void printSpecifics(std::span<const std::vector<int>> inventories, std::FILE* file) {
+		//No bigger than what gets printed, so a handful of inventories doesn't get a whole 1MB buffer.
+		constexpr std::size_t maxCapacity{ 1 << 20 };
+		const std::size_t needed{ inventories.size() < maxCapacity / maxSpecificsSize ? inventories.size() * maxSpecificsSize : maxCapacity };
+		OutputBuffer out{ file, std::max(needed, maxSpecificsSize) };
+		for (const std::vector<int>& inventory : inventories)
+			printSpecifics(out, inventory);
+		out.flush();
+	}
+}
@@ -0,0 +1,44 @@
+#ifndef ITEMS_H
+#define ITEMS_H
+
+#include <array>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "EnumMeta.h"
+
+class OutputBuffer;
+
+//16.x Q2 items, moved out of 15.1-17.x.cpp so the inventory printing code can share them.
+namespace Items {
+	enum Types {
+		health_potion,
+		torch,
+		arrow,
+		max_value,
+	};
+
+	//Plural of every item, worked out once here instead of checking for "torch" every time a line is printed.
+	constexpr std::array<std::string_view, max_value> pluralNames{ "health potions", "torches", "arrows" };
+
+	//"You have 5 torches in your inventory." for every item, written straight into out.
+	//Counts past max_value are ignored. Doesn't allocate.
+	void printSpecifics(OutputBuffer& out, std::span<const int> counts);
+
+	//One inventory's lines, rendered into a buffer on the stack and written with one fwrite. Doesn't allocate.
+	void printSpecifics(std::span<const int> counts, std::FILE* file = stdout);
+
+	//printSpecifics() for every inventory in the span, collected in an OutputBuffer(no bigger than the
+	//output, up to 1MB) and written out in big chunks.
+	void printSpecifics(std::span<const std::vector<int>> inventories, std::FILE* file = stdout);
+}
+
+template <>
+struct EnumMeta::Traits<Items::Types> {
+	static constexpr std::array<std::string_view, 3> names{ "health potion", "torch", "arrow" };
+	static constexpr Items::Types end{ Items::max_value };
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+	const HANDLE file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+	m_file = file;
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		return;
+	m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping)
+		return;
+	m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_data)
+		m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+	const int fd{ ::open(path.c_str(), O_RDONLY) };
+	if (fd < 0)
+		return;
+	struct stat info {};
+	if (fstat(fd, &info) == 0 && info.st_size > 0) {
+		void* data{ mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+		if (data != MAP_FAILED) {
+			m_data = static_cast<const char*>(data);
+			m_size = static_cast<std::size_t>(info.st_size);
+		}
+	}
+	::close(fd); //the mapping stays valid after the descriptor is closed
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	if (m_file)
+		CloseHandle(m_file);
+#else
+	if (m_data)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
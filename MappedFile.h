@@ -0,0 +1,32 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+//Read only view of a whole file through the OS's file mapping(mmap, or CreateFileMapping on Windows).
+//Pages are only read in when they're touched, and nothing gets copied through a read buffer first.
+//An empty or missing file gives a size() of 0 and a null data().
+class MappedFile {
+private:
+	const char* m_data{};
+	std::size_t m_size{ 0 };
+#ifdef _WIN32
+	void* m_file{}; //HANDLEs, kept as void* so this header doesn't need windows.h
+	void* m_mapping{};
+#endif
+
+public:
+	explicit MappedFile(const std::filesystem::path& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const char* data() const { return m_data; }
+	std::size_t size() const { return m_size; }
+	std::string_view view() const { return { m_data, m_size }; }
+};
+
+#endif
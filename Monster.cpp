@@ -0,0 +1,110 @@
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+#include "Monster.h"
+#include "OutputBuffer.h"
+#include "Random.h"
+
+Monster::Monster(Type type, StringPool::Handle name, StringPool::Handle roar, int hp)
+	: m_type{type}, m_name{name}, m_roar{roar}, m_hp{hp}
+{ }
+
+Monster::Monster(Type type, std::string_view name, std::string_view roar, int hp)
+	: Monster{ type, StringPool::global().intern(name), StringPool::global().intern(roar), hp }
+{ }
+
+void Monster::print() const {
+	if (m_hp <= 0) {
+		std::cout << getName() << " the " << getTypeString() << " is dead.\n";
+	}
+	else {
+		std::cout << getName() << " the " << getTypeString() << " has " << m_hp << " hit points and says " << getRoar() << ".\n";
+	}
+}
+
+namespace {
+	constexpr std::string_view the{ " the " };
+	constexpr std::string_view isDead{ " is dead.\n" };
+	constexpr std::string_view has{ " has " };
+	constexpr std::string_view saysText{ " hit points and says " };
+	constexpr std::string_view end{ ".\n" };
+	constexpr std::size_t maxDigits{ 11 }; //"-2147483648"
+
+	//Most bytes print(OutputBuffer&) can write for this monster.
+	std::size_t lineSize(const Monster& monster) {
+		return monster.getName().size() + the.size() + monster.getTypeString().size() + has.size() + maxDigits
+			+ saysText.size() + monster.getRoar().size() + end.size();
+	}
+
+	void copy(char*& out, std::string_view text) {
+		std::memcpy(out, text.data(), text.size());
+		out += text.size();
+	}
+}
+
+void Monster::print(OutputBuffer& out) const {
+	//Reserve room for the whole line once, then fill it in without any more checks.
+	const std::size_t maxBytes{ lineSize(*this) };
+	char* const start{ out.reserve(maxBytes) };
+	char* pos{ start };
+
+	copy(pos, getName());
+	copy(pos, the);
+	copy(pos, getTypeString());
+	if (m_hp <= 0) {
+		copy(pos, isDead);
+	}
+	else {
+		copy(pos, has);
+		pos = std::to_chars(pos, start + maxBytes, m_hp).ptr;
+		copy(pos, saysText);
+		copy(pos, getRoar());
+		copy(pos, end);
+	}
+	out.commit(static_cast<std::size_t>(pos - start));
+}
+
+void printMonsters(std::span<const Monster> monsters, std::FILE* file) {
+	//Size the buffer for everything up front so there is exactly one write at the end.
+	std::size_t bytes{ 0 };
+	for (const Monster& monster : monsters)
+		bytes += lineSize(monster);
+
+	OutputBuffer out{ file, bytes > 0 ? bytes : 1 };
+	for (const Monster& monster : monsters)
+		monster.print(out);
+	out.flush();
+}
+
+namespace MonsterGenerator {
+	namespace {
+		StringPool::Handle pick(std::size_t count, int x, auto handle) {
+			if (count == 0)
+				return StringPool::Handle{};
+			return handle((x >= 0 && static_cast<std::size_t>(x) < count) ? static_cast<std::size_t>(x) : count - 1);
+		}
+
+		//Random index into a list of count things. Index 0 of an empty list is "" in getName()/getRoar().
+		int roll(std::size_t count) {
+			return count == 0 ? 0 : Random::get(0, static_cast<int>(count) - 1);
+		}
+	}
+
+	StringPool::Handle getName(Monster::Type type, int x) {
+		const MonsterCatalog& catalog{ MonsterCatalog::global() };
+		return pick(catalog.monsterNameCount(type), x, [&](std::size_t i) { return catalog.monsterNameHandle(type, i); });
+	}
+	StringPool::Handle getRoar(Monster::Type type, int x) {
+		const MonsterCatalog& catalog{ MonsterCatalog::global() };
+		return pick(catalog.roarCount(type), x, [&](std::size_t i) { return catalog.roarHandle(type, i); });
+	}
+
+	Monster generate() {
+		const MonsterCatalog& catalog{ MonsterCatalog::global() };
+		const auto type{ static_cast<Monster::Type>(roll(catalog.size())) };
+		//Braced init runs left to right, so it's type, name, roar, then hp.
+		return Monster{ type, getName(type, roll(catalog.monsterNameCount(type))), getRoar(type, roll(catalog.roarCount(type))),
+			Random::get(0, 2 * catalog.baseHp(type)) };
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef MONSTER_H
+#define MONSTER_H
+
+#include <cstdio>
+#include <span>
+#include <string_view>
+
+#include "MonsterCatalog.h"
+#include "StringPool.h"
+
+class OutputBuffer;
+
+//15.x quiz Monster, moved out of 15.1-17.x.cpp so the monster storage/generation code can share it.
+class Monster {
+public:
+	//Index into MonsterCatalog::global(). The types used to be an enum here, now they come from the catalog file.
+	using Type = MonsterCatalog::TypeId;
+
+private:
+	//Names and roars are handles into StringPool::global(), so copying a Monster never copies any text
+	//and every skeleton named "Sheldon" shares the same "Sheldon".
+	Type m_type{};
+	StringPool::Handle m_name{};
+	StringPool::Handle m_roar{};
+	int m_hp{0};
+
+public:
+	Monster(Type type, StringPool::Handle name, StringPool::Handle roar, int hp);
+	//Interns name and roar.
+	Monster(Type type, std::string_view name, std::string_view roar, int hp);
+
+	//One array index into the catalog.
+	std::string_view getTypeString() const { return MonsterCatalog::global().name(m_type); }
+
+	Type getType() const { return m_type; }
+	std::string_view getName() const { return m_name.view(); }
+	std::string_view getRoar() const { return m_roar.view(); }
+	StringPool::Handle getNameHandle() const { return m_name; }
+	StringPool::Handle getRoarHandle() const { return m_roar; }
+	int getHp() const { return m_hp; }
+	bool isAlive() const { return m_hp > 0; }
+
+	// hp stops at 0 so it can't underflow.
+	void takeDamage(int damage) { m_hp = (m_hp - damage > 0) ? m_hp - damage : 0; }
+
+	void print() const;
+	//Same text as print(), appended to out instead of going through std::cout. Doesn't allocate.
+	void print(OutputBuffer& out) const;
+};
+
+//Prints every monster the same way print() does, but renders them all into one buffer first
+//and hands it to the OS with a single write. Use this for dumping battle state.
+void printMonsters(std::span<const Monster> monsters, std::FILE* file = stdout);
+
+namespace MonsterGenerator {
+	//Name/roar x of the type in MonsterCatalog::global(). These used to be switches building a new std::string on
+	//every call, now they hand back handles the catalog interned once.
+	//Anything out of range gets the last one(that was the switch's default case), a type without any gets "".
+	StringPool::Handle getName(Monster::Type type, int x);
+	StringPool::Handle getRoar(Monster::Type type, int x);
+	//A random type from the catalog with one of its names and roars, and 0 to twice its base hp.
+	Monster generate();
+}
+
+#endif
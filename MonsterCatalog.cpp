@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#include "MappedFile.h"
+#include "MonsterCatalog.h"
+#include "OutputBuffer.h"
+
+namespace {
+	constexpr std::array<char, 4> binaryMagic{ 'M', 'C', 'A', 'T' };
+	constexpr std::uint32_t binaryVersion{ 2 }; //2 added monster names
+
+	struct BinaryHeader {
+		std::array<char, 4> magic{};
+		std::uint32_t version{};
+		std::uint32_t typeCount{};
+		std::uint32_t listCount{};
+		std::uint32_t textBytes{};
+	};
+
+	//Copies count Ts out of the mapped file at offset. The mapping has no alignment promises past the page, so no casts.
+	template <typename T>
+	void copyArray(const MappedFile& file, std::size_t offset, std::vector<T>& out, std::size_t count) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		out.resize(count);
+		if (count > 0)
+			std::memcpy(out.data(), file.data() + offset, sizeof(T) * count);
+	}
+
+	//Splits text on separator, the pieces stay pointing into text.
+	void split(std::string_view text, char separator, std::vector<std::string_view>& out) {
+		out.clear();
+		while (true) {
+			const std::size_t end{ text.find(separator) };
+			out.push_back(text.substr(0, end));
+			if (end == std::string_view::npos)
+				return;
+			text.remove_prefix(end + 1);
+		}
+	}
+
+	template <typename T>
+	void writeArray(std::FILE* file, const T* data, std::size_t count) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		std::fwrite(data, sizeof(T), count, file);
+	}
+}
+
+MonsterCatalog::TextRef MonsterCatalog::addText(std::string_view text) {
+	const TextRef ref{ static_cast<std::uint32_t>(m_text.size()), static_cast<std::uint32_t>(text.size()) };
+	m_text.append(text);
+	return ref;
+}
+
+MonsterCatalog::TypeId MonsterCatalog::addType(std::string_view name, int baseHp, std::span<const std::string_view> monsterNames, std::span<const std::string_view> roars) {
+	TypeRecord record{ addText(name), std::clamp(baseHp, 0, maxBaseHp),
+		static_cast<std::uint32_t>(m_lists.size()), static_cast<std::uint32_t>(monsterNames.size()),
+		static_cast<std::uint32_t>(m_lists.size() + monsterNames.size()), static_cast<std::uint32_t>(roars.size()) };
+	for (const std::string_view monsterName : monsterNames)
+		m_lists.push_back(addText(monsterName));
+	for (const std::string_view roar : roars)
+		m_lists.push_back(addText(roar));
+
+	m_types.push_back(record);
+	return static_cast<TypeId>(m_types.size() - 1);
+}
+
+bool MonsterCatalog::isValid() const {
+	auto inText{ [this](TextRef ref) {
+		return ref.offset <= m_text.size() && ref.length <= m_text.size() - ref.offset;
+	} };
+	auto inLists{ [this](std::uint32_t first, std::uint32_t count) {
+		return first <= m_lists.size() && count <= m_lists.size() - first;
+	} };
+
+	for (const TypeRecord& type : m_types) {
+		if (!inText(type.name) || type.baseHp < 0 || type.baseHp > maxBaseHp
+			|| !inLists(type.firstName, type.nameCount) || !inLists(type.firstRoar, type.roarCount))
+			return false;
+	}
+	for (const TextRef ref : m_lists) {
+		if (!inText(ref))
+			return false;
+	}
+	return true;
+}
+
+void MonsterCatalog::intern() {
+	m_handles.clear();
+	m_handles.reserve(m_lists.size());
+	for (const TextRef ref : m_lists)
+		m_handles.push_back(StringPool::global().intern(text(ref)));
+}
+
+std::optional<MonsterCatalog::TypeId> MonsterCatalog::find(std::string_view name) const {
+	for (TypeId id{ 0 }; id < size(); ++id) {
+		if (this->name(id) == name)
+			return id;
+	}
+	return std::nullopt;
+}
+
+std::optional<MonsterCatalog> MonsterCatalog::loadText(const std::string& path) {
+	//The lines are parsed straight out of the mapping, nothing is read into a buffer first.
+	const MappedFile file{ path };
+	if (!file.data()) //missing or empty
+		return std::nullopt;
+	const std::string_view contents{ file.view() };
+
+	MonsterCatalog catalog{};
+	catalog.m_text.reserve(contents.size());
+
+	std::vector<std::string_view> fields{};
+	std::vector<std::string_view> monsterNames{};
+	std::string_view rest{ contents };
+	while (!rest.empty()) {
+		const std::size_t lineEnd{ rest.find('\n') };
+		std::string_view line{ rest.substr(0, lineEnd) };
+		rest.remove_prefix(lineEnd == std::string_view::npos ? rest.size() : lineEnd + 1);
+
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		//Split on tabs: type, hp, names, then any number of roars.
+		split(line, '\t', fields);
+		if (fields.size() < 2)
+			return std::nullopt;
+
+		int baseHp{};
+		const auto [end, error] { std::from_chars(fields[1].data(), fields[1].data() + fields[1].size(), baseHp) };
+		if (error != std::errc{} || end != fields[1].data() + fields[1].size() || baseHp < 0 || baseHp > maxBaseHp)
+			return std::nullopt;
+
+		monsterNames.clear();
+		if (fields.size() > 2 && !fields[2].empty())
+			split(fields[2], '|', monsterNames);
+
+		const std::span<const std::string_view> roars{ fields.size() > 3 ? std::span{ fields }.subspan(3) : std::span<const std::string_view>{} };
+		catalog.addType(fields[0], baseHp, monsterNames, roars);
+	}
+
+	return catalog;
+}
+
+std::optional<MonsterCatalog> MonsterCatalog::loadBinary(const std::string& path) {
+	const MappedFile file{ path };
+	BinaryHeader header{};
+	if (file.size() < sizeof(header))
+		return std::nullopt;
+	std::memcpy(&header, file.data(), sizeof(header));
+
+	const std::size_t typesOffset{ sizeof(header) };
+	const std::size_t listsOffset{ typesOffset + sizeof(TypeRecord) * header.typeCount };
+	const std::size_t textOffset{ listsOffset + sizeof(TextRef) * header.listCount };
+	//The sizes in the header have to add up to the file size, so a damaged header can't make us read past the end
+	//or allocate gigabytes.
+	if (header.magic != binaryMagic || header.version != binaryVersion
+		|| static_cast<unsigned long long>(file.size()) != sizeof(header) + sizeof(TypeRecord) * 1ull * header.typeCount
+			+ sizeof(TextRef) * 1ull * header.listCount + header.textBytes)
+		return std::nullopt;
+
+	MonsterCatalog catalog{};
+	copyArray(file, typesOffset, catalog.m_types, header.typeCount);
+	copyArray(file, listsOffset, catalog.m_lists, header.listCount);
+	catalog.m_text.assign(file.data() + textOffset, header.textBytes);
+
+	if (!catalog.isValid())
+		return std::nullopt;
+	return catalog;
+}
+
+bool MonsterCatalog::saveText(const std::string& path) const {
+	std::FILE* file{ std::fopen(path.c_str(), "wb") };
+	if (!file)
+		return false;
+
+	{
+		OutputBuffer out{ file };
+		out.append("# type\tbase hp\tname|name|...\troars...\n");
+		for (TypeId id{ 0 }; id < size(); ++id) {
+			out.append(name(id));
+			out.append('\t');
+			out.appendNumber(baseHp(id));
+			out.append('\t');
+			for (std::size_t i{ 0 }; i < monsterNameCount(id); ++i) {
+				if (i > 0)
+					out.append('|');
+				out.append(monsterName(id, i));
+			}
+			for (std::size_t i{ 0 }; i < roarCount(id); ++i) {
+				out.append('\t');
+				out.append(roar(id, i));
+			}
+			out.append('\n');
+		}
+	}
+	return std::fclose(file) == 0;
+}
+
+bool MonsterCatalog::saveBinary(const std::string& path) const {
+	std::FILE* file{ std::fopen(path.c_str(), "wb") };
+	if (!file)
+		return false;
+
+	const BinaryHeader header{ binaryMagic, binaryVersion, static_cast<std::uint32_t>(m_types.size()),
+		static_cast<std::uint32_t>(m_lists.size()), static_cast<std::uint32_t>(m_text.size()) };
+	writeArray(file, &header, 1);
+	writeArray(file, m_types.data(), m_types.size());
+	writeArray(file, m_lists.data(), m_lists.size());
+	writeArray(file, m_text.data(), m_text.size());
+
+	const bool ok{ !std::ferror(file) };
+	return std::fclose(file) == 0 && ok;
+}
+
+MonsterCatalog MonsterCatalog::builtIn() {
+	//Every type gets the 15.x quiz names and roars. Base hp is the middle of what generate() rolls, so a skeleton
+	//still rolls 0-100 like the quiz, and bigger monsters get more.
+	constexpr std::array<std::string_view, 6> names{ "Sheldon", "Thrall", "Temarri", "Mythgor", "Shawn", "Lameo" };
+	constexpr std::array<std::string_view, 6> roars{ "*ROAR*", "*rawr*", "*shiver*", "*crunch*", "*growl*", "I'm scared, please leave me alone." };
+
+	MonsterCatalog catalog{};
+	catalog.addType("dragon", 100, names, roars);
+	catalog.addType("goblin", 20, names, roars);
+	catalog.addType("ogre", 60, names, roars);
+	catalog.addType("orc", 40, names, roars);
+	catalog.addType("skeleton", 50, names, roars);
+	catalog.addType("troll", 70, names, roars);
+	catalog.addType("vampire", 45, names, roars);
+	catalog.addType("zombie", 35, names, roars);
+	return catalog;
+}
+
+const MonsterCatalog& MonsterCatalog::global() {
+	static const MonsterCatalog s_catalog{ [] {
+		std::optional<MonsterCatalog> catalog{ loadBinary("monsters.bin") };
+		if (!catalog || catalog->size() == 0)
+			catalog = loadText("monsters.txt");
+		if (!catalog || catalog->size() == 0)
+			catalog = builtIn();
+		catalog->intern();
+		return std::move(*catalog);
+	}() };
+	return s_catalog;
+}
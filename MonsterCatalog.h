@@ -0,0 +1,105 @@
+#ifndef MONSTERCATALOG_H
+#define MONSTERCATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StringPool.h"
+
+// Monster types loaded at runtime instead of being compiled in.
+// Monster used to have its own enum, a name switch and MonsterGenerator's name and roar switches, so adding a type
+// meant editing all of them and rebuilding. A catalog is a file listing every type's name, base hp, the names
+// monsters of that type get and their roars, loaded into a dense table where the type id is the index, so looking a
+// type up is still just an array access. Monster holds a type id, and everything about the type comes from global().
+//
+// Two file formats:
+// Text, one type per line, fields separated by tabs, monster names separated by |, lines starting with # are ignored:
+//	type<TAB>baseHp<TAB>name|name|...<TAB>roar<TAB>roar...
+// Binary, written by saveBinary(). It is the in-memory table dumped as is, so loading it is mapping the file(MappedFile),
+// a bounds check and a memcpy per table, no parsing. It uses the machine's byte order, so it isn't meant to be moved
+// between machines.
+class MonsterCatalog {
+public:
+	using TypeId = std::uint32_t;
+
+	// Base hp is clamped to this, so rolling up to twice the base hp can't overflow.
+	static constexpr int maxBaseHp{ 1'000'000 };
+
+private:
+	// Offsets into m_text.
+	struct TextRef {
+		std::uint32_t offset{};
+		std::uint32_t length{};
+	};
+
+	// One row per type. Its monster names are m_lists[firstName, firstName + nameCount),
+	// its roars m_lists[firstRoar, firstRoar + roarCount).
+	struct TypeRecord {
+		TextRef name{};
+		std::int32_t baseHp{};
+		std::uint32_t firstName{};
+		std::uint32_t nameCount{};
+		std::uint32_t firstRoar{};
+		std::uint32_t roarCount{};
+	};
+
+	std::vector<TypeRecord> m_types{};
+	std::vector<TextRef> m_lists{};
+	std::string m_text{};
+	//m_lists interned into StringPool::global(), only filled in by intern().
+	std::vector<StringPool::Handle> m_handles{};
+
+	TextRef addText(std::string_view text);
+	std::string_view text(TextRef ref) const { return std::string_view{ m_text }.substr(ref.offset, ref.length); }
+	// Checks every offset in a loaded file points inside m_text or m_lists, and every base hp is in range.
+	bool isValid() const;
+	void intern();
+
+public:
+	// Returns the id of the new type. Nothing saved with saveText() can contain tabs or newlines, and names can't
+	// contain |.
+	TypeId addType(std::string_view name, int baseHp, std::span<const std::string_view> monsterNames, std::span<const std::string_view> roars);
+	TypeId addType(std::string_view name, int baseHp, std::initializer_list<std::string_view> monsterNames, std::initializer_list<std::string_view> roars) {
+		return addType(name, baseHp, std::span{ monsterNames.begin(), monsterNames.size() }, std::span{ roars.begin(), roars.size() });
+	}
+
+	std::size_t size() const { return m_types.size(); }
+
+	// id must be < size(), and index < the matching count.
+	std::string_view name(TypeId id) const { return text(m_types[id].name); }
+	int baseHp(TypeId id) const { return m_types[id].baseHp; }
+	std::size_t monsterNameCount(TypeId id) const { return m_types[id].nameCount; }
+	std::string_view monsterName(TypeId id, std::size_t index) const { return text(m_lists[m_types[id].firstName + index]); }
+	std::size_t roarCount(TypeId id) const { return m_types[id].roarCount; }
+	std::string_view roar(TypeId id, std::size_t index) const { return text(m_lists[m_types[id].firstRoar + index]); }
+
+	// Same as monsterName()/roar(), as handles into StringPool::global(). Only global() has these.
+	StringPool::Handle monsterNameHandle(TypeId id, std::size_t index) const { return m_handles[m_types[id].firstName + index]; }
+	StringPool::Handle roarHandle(TypeId id, std::size_t index) const { return m_handles[m_types[id].firstRoar + index]; }
+
+	// Looks through every type, so it's for setup code("give me the orc"), not for every monster.
+	std::optional<TypeId> find(std::string_view name) const;
+
+	// These return std::nullopt if the file can't be opened, is empty or isn't a valid catalog.
+	static std::optional<MonsterCatalog> loadText(const std::string& path);
+	static std::optional<MonsterCatalog> loadBinary(const std::string& path);
+
+	// Return false if the file couldn't be written.
+	bool saveText(const std::string& path) const;
+	bool saveBinary(const std::string& path) const;
+
+	// The 15.x monster types with the names and roars from the 15.x quiz. Used when there is no catalog file.
+	static MonsterCatalog builtIn();
+
+	// The catalog Monster and MonsterGenerator use, loaded the first time it's needed: monsters.bin if it loads,
+	// otherwise monsters.txt, otherwise builtIn(). It never changes after that, so any thread can read it.
+	static const MonsterCatalog& global();
+};
+
+#endif
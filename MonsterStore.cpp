@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <random>
+
+#include "MonsterStore.h"
+
+namespace {
+	// Monsters per random number generator in generateBatch(). Big enough that seeding a std::mt19937
+	// is a tiny part of the work, small enough that there are plenty of chunks to spread across threads.
+	constexpr std::size_t batchChunkSize = 16 * 1024;
+}
+
+void MonsterStore::reserve(std::size_t count) {
+	m_types.reserve(count);
+	m_hp.reserve(count);
+	m_names.reserve(count);
+	m_roars.reserve(count);
+}
+
+void MonsterStore::resize(std::size_t count) {
+	m_types.resize(count);
+	m_hp.resize(count);
+	m_names.resize(count);
+	m_roars.resize(count);
+}
+
+void MonsterStore::set(std::size_t index, Monster::Type type, StringPool::Handle name, StringPool::Handle roar, int hp) {
+	m_types[index] = type;
+	m_hp[index] = hp;
+	m_names[index] = name;
+	m_roars[index] = roar;
+}
+
+std::size_t MonsterStore::add(Monster::Type type, StringPool::Handle name, StringPool::Handle roar, int hp) {
+	m_types.push_back(type);
+	m_hp.push_back(hp);
+	m_names.push_back(name);
+	m_roars.push_back(roar);
+	return m_hp.size() - 1;
+}
+
+std::size_t MonsterStore::add(Monster::Type type, std::string_view name, std::string_view roar, int hp) {
+	return add(type, StringPool::global().intern(name), StringPool::global().intern(roar), hp);
+}
+
+std::size_t MonsterStore::add(const Monster& monster) {
+	return add(monster.getType(), monster.getNameHandle(), monster.getRoarHandle(), monster.getHp());
+}
+
+Monster MonsterStore::toMonster(std::size_t index) const {
+	return Monster{ type(index), m_names[index], m_roars[index], hp(index) };
+}
+
+std::size_t MonsterStore::aliveCount() const {
+	// Adding the comparison result instead of using an if keeps the loop branch free.
+	std::size_t count{ 0 };
+	for (const std::int32_t hp : m_hp)
+		count += (hp > 0);
+	return count;
+}
+
+void MonsterStore::damageAll(int damage) {
+	for (std::int32_t& hp : m_hp) {
+		const std::int32_t left{ hp - damage };
+		hp = left > 0 ? left : 0;
+	}
+}
+
+std::vector<std::uint32_t> MonsterStore::filterByType(Monster::Type type) const {
+	// Write every index, but only move forward when it matches. No branch for the compiler to mispredict.
+	std::vector<std::uint32_t> matches(m_types.size());
+	std::size_t count{ 0 };
+	for (std::size_t i{ 0 }; i < m_types.size(); ++i) {
+		matches[count] = static_cast<std::uint32_t>(i);
+		count += (m_types[i] == type);
+	}
+	matches.resize(count);
+	return matches;
+}
+
+std::size_t MonsterStore::memoryUsage() const {
+	return m_types.capacity() * sizeof(Monster::Type) + m_hp.capacity() * sizeof(std::int32_t)
+		+ m_names.capacity() * sizeof(StringPool::Handle) + m_roars.capacity() * sizeof(StringPool::Handle);
+}
+
+namespace MonsterGenerator {
+	MonsterStore generateBatch(std::size_t count, std::uint64_t seed, int threadCount) {
+		MonsterStore store{};
+		store.resize(count);
+
+		const MonsterCatalog& catalog{ MonsterCatalog::global() };
+		// A random index into a list of count things, like generate()'s roll().
+		auto roll{ [](std::mt19937& mt, std::size_t count) {
+			return count == 0 ? std::size_t{ 0 } : std::uniform_int_distribution<std::size_t>{ 0, count - 1 }(mt);
+		} };
+
+		const std::size_t chunks{ (count + batchChunkSize - 1) / batchChunkSize };
+		Parallel::forEachIndex(chunks, threadCount, [&](std::size_t chunk, int) {
+			std::seed_seq seq{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), static_cast<std::uint32_t>(chunk) };
+			std::mt19937 mt{ seq };
+
+			const std::size_t end{ std::min(count, (chunk + 1) * batchChunkSize) };
+			for (std::size_t i{ chunk * batchChunkSize }; i < end; ++i) {
+				// Same order of random calls as generate(): type, name, roar, then hp. Everything is an index into the
+				// catalog, the handles were interned when it was loaded.
+				const auto type{ static_cast<Monster::Type>(roll(mt, catalog.size())) };
+				const std::size_t names{ catalog.monsterNameCount(type) };
+				const std::size_t roars{ catalog.roarCount(type) };
+				const std::size_t name{ roll(mt, names) };
+				const std::size_t roar{ roll(mt, roars) };
+				const int hp{ std::uniform_int_distribution{ 0, 2 * catalog.baseHp(type) }(mt) };
+				store.set(i, type, names == 0 ? StringPool::Handle{} : catalog.monsterNameHandle(type, name),
+					roars == 0 ? StringPool::Handle{} : catalog.roarHandle(type, roar), hp);
+			}
+		});
+
+		return store;
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef MONSTERSTORE_H
+#define MONSTERSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Monster.h"
+#include "Parallel.h"
+#include "StringPool.h"
+
+// Stores lots of monsters as columns("structure of arrays") instead of a std::vector<Monster>.
+// A std::vector<Monster> keeps each monster's type, hp, name and roar handles next to each other, so a damage or
+// alive check over all of them drags the name and roar handles through the cache too, even though it never looks
+// at them. Here each field gets its own tightly packed array:
+// type, hp and name/roar handles as 4 bytes each.
+// Bulk operations walk one column at a time with simple loops, which the compiler can vectorize.
+class MonsterStore {
+private:
+	std::vector<Monster::Type> m_types{};
+	std::vector<std::int32_t> m_hp{};
+	std::vector<StringPool::Handle> m_names{};
+	std::vector<StringPool::Handle> m_roars{};
+
+public:
+	void reserve(std::size_t count);
+	// New monsters are dead, type 0, with empty names and roars(default handles) until set() is called on them.
+	void resize(std::size_t count);
+
+	// Overwrites one monster. Different threads can set() different indices at the same time.
+	void set(std::size_t index, Monster::Type type, StringPool::Handle name, StringPool::Handle roar, int hp);
+
+	// Returns the index of the new monster.
+	std::size_t add(Monster::Type type, StringPool::Handle name, StringPool::Handle roar, int hp);
+	std::size_t add(Monster::Type type, std::string_view name, std::string_view roar, int hp);
+	std::size_t add(const Monster& monster);
+
+	std::size_t size() const { return m_hp.size(); }
+
+	Monster::Type type(std::size_t index) const { return m_types[index]; }
+	int hp(std::size_t index) const { return m_hp[index]; }
+	std::string_view name(std::size_t index) const { return m_names[index].view(); }
+	std::string_view roar(std::size_t index) const { return m_roars[index].view(); }
+
+	// Copies one monster back out as a regular Monster.
+	Monster toMonster(std::size_t index) const;
+
+	// Bulk queries over the whole store.
+	std::size_t aliveCount() const;
+	void damageAll(int damage);
+	std::vector<std::uint32_t> filterByType(Monster::Type type) const;
+
+	// Bytes used by the columns(counting capacity, not just size). The strings themselves are in
+	// StringPool::global() and shared with everything else, so they aren't counted.
+	std::size_t memoryUsage() const;
+};
+
+namespace MonsterGenerator {
+	// Makes count monsters the same way generate() does, split over threadCount threads.
+	// The monsters are split into fixed size chunks and each chunk gets its own random number generator seeded
+	// from (seed, chunk number). So the same seed gives the same monsters no matter how many threads are used.
+	MonsterStore generateBatch(std::size_t count, std::uint64_t seed, int threadCount = Parallel::defaultThreadCount());
+}
+
+#endif
@@ -42,6 +42,8 @@ namespace Addition
     }
 }
 
+//Note: s_val is shared by every caller, so this isn't safe to call from more than one thread at once.
+//ShardedCounter.h has a counter that is.
 void incrementAndPrint()
 {
     static int s_val = 1;
@@ -0,0 +1,37 @@
+#include <algorithm>
+#include <cstring>
+
+#include "OutputBuffer.h"
+
+OutputBuffer::OutputBuffer(std::FILE* file, std::size_t capacity)
+	: m_file{ file }, m_buffer(capacity)
+{ }
+
+OutputBuffer::~OutputBuffer()
+{
+	flush();
+}
+
+void OutputBuffer::append(std::string_view text)
+{
+	// Text bigger than the buffer gets copied over in buffer sized pieces.
+	while (!text.empty())
+	{
+		const std::size_t bytes{ std::min(text.size(), m_buffer.size()) };
+		std::memcpy(reserve(bytes), text.data(), bytes);
+		commit(bytes);
+		text.remove_prefix(bytes);
+	}
+}
+
+void OutputBuffer::flush()
+{
+	if (m_used == 0)
+		return;
+
+	// We write straight from our buffer, so there is no point in the FILE buffering it again.
+	std::fwrite(m_buffer.data(), 1, m_used, m_file);
+	std::fflush(m_file);
+	m_written += m_used;
+	m_used = 0;
+}
@@ -0,0 +1,70 @@
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+// Collects output in one big buffer and hands it to the OS in large writes, instead of going through
+// std::cout << for every word. Used for the code that prints millions of lines(fizzbuzz, monster dumps, etc.)
+// Nothing here allocates after the constructor(unless a single reserve() is bigger than the buffer).
+class OutputBuffer
+{
+private:
+	std::FILE* m_file{};
+	std::vector<char> m_buffer{};
+	std::size_t m_used{ 0 };
+	unsigned long long m_written{ 0 };
+
+public:
+	// capacity is how many bytes get collected before each write.
+	explicit OutputBuffer(std::FILE* file = stdout, std::size_t capacity = 1 << 20);
+	~OutputBuffer();
+
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+	// Makes sure at least bytes bytes are free(flushing if needed) and returns where to write them.
+	// Call commit() afterwards with how many were actually used.
+	char* reserve(std::size_t bytes)
+	{
+		if (m_buffer.size() - m_used < bytes)
+		{
+			flush();
+			// Only happens if someone asks for more than the whole buffer at once.
+			if (m_buffer.size() < bytes)
+				m_buffer.resize(bytes);
+		}
+		return m_buffer.data() + m_used;
+	}
+
+	void commit(std::size_t bytes) { m_used += bytes; }
+
+	void append(std::string_view text);
+
+	void append(char c)
+	{
+		*reserve(1) = c;
+		commit(1);
+	}
+
+	template <typename T>
+	void appendNumber(T value)
+	{
+		// 20 digits and a sign is enough for any 64 bit integer.
+		char* out{ reserve(21) };
+		commit(static_cast<std::size_t>(std::to_chars(out, out + 21, value).ptr - out));
+	}
+
+	// Writes everything collected so far with a single fwrite.
+	void flush();
+
+	std::size_t capacity() const { return m_buffer.size(); }
+
+	// Total bytes handed to the file so far.
+	unsigned long long bytesWritten() const { return m_written; }
+};
+
+#endif
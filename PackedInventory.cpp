@@ -0,0 +1,54 @@
+#include <bit>
+#include <cstring>
+
+#include "PackedInventory.h"
+
+// SSE2 is always there on x64, for anything else the plain loops are used.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PACKEDINVENTORY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace PackedInventoryKernels
+{
+	std::uint64_t sumBytes(const unsigned char* bytes, std::size_t count)
+	{
+		std::uint64_t sum{ 0 };
+		std::size_t i{ 0 };
+
+#ifdef PACKEDINVENTORY_SSE2
+		// _mm_sad_epu8 against zero adds up each half of 16 bytes into a 64 bit lane. The lanes can't overflow,
+		// each add puts in at most 8 * 255.
+		const __m128i zero{ _mm_setzero_si128() };
+		__m128i totals{ _mm_setzero_si128() };
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m128i chunk{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)) };
+			totals = _mm_add_epi64(totals, _mm_sad_epu8(chunk, zero));
+		}
+		std::uint64_t lanes[2]{};
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), totals);
+		sum = lanes[0] + lanes[1];
+#endif
+
+		for (; i < count; ++i)
+			sum += bytes[i];
+		return sum;
+	}
+
+	std::uint64_t popcountBytes(const unsigned char* bytes, std::size_t count)
+	{
+		// 8 bytes at a time, std::popcount compiles to the popcnt instruction where the CPU has it.
+		std::uint64_t sum{ 0 };
+		std::size_t i{ 0 };
+		for (; i + sizeof(std::uint64_t) <= count; i += sizeof(std::uint64_t))
+		{
+			std::uint64_t word{};
+			std::memcpy(&word, bytes + i, sizeof(word));
+			sum += static_cast<std::uint64_t>(std::popcount(word));
+		}
+		for (; i < count; ++i)
+			sum += static_cast<std::uint64_t>(std::popcount(static_cast<unsigned int>(bytes[i])));
+		return sum;
+	}
+}
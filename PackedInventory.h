@@ -0,0 +1,145 @@
+#ifndef PACKEDINVENTORY_H
+#define PACKEDINVENTORY_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Inventory counts packed into a single integer, with a chosen number of bits per item type.
+// std::array<int, 4> is 16 bytes per player, PackedInventory<8, 8, 8, 8> is 4 bytes(255 of each is plenty).
+// Counts saturate: adding to a full slot stops at the max, removing from an empty slot stops at 0.
+//
+//	PackedInventory<4, 6, 8> items{};	// up to 15 of item 0, 63 of item 1, 255 of item 2, fits in 3 bytes -> uint32_t
+//	items.add(2, 10);
+//	items.total();						// 10
+//
+// countAll() adds up the counts of a whole array of inventories. When every slot is 8 bits it is a byte sum
+// (SSE2 sum-of-absolute-differences, 16 bytes per instruction), when every slot is 1 bit(an "owns this item" bitset)
+// it is a popcount, otherwise each slot is masked out and added separately.
+namespace PackedInventoryKernels
+{
+	// Sum of every byte in [bytes, bytes + count).
+	std::uint64_t sumBytes(const unsigned char* bytes, std::size_t count);
+	// Number of set bits in [bytes, bytes + count).
+	std::uint64_t popcountBytes(const unsigned char* bytes, std::size_t count);
+}
+
+template <int... Bits>
+class PackedInventory
+{
+public:
+	static constexpr int itemCount{ sizeof...(Bits) };
+	static constexpr std::array<int, itemCount> widths{ Bits... };
+	static constexpr int totalBits{ (Bits + ... + 0) };
+
+	static_assert(itemCount > 0, "PackedInventory needs at least one item type");
+	static_assert(((Bits > 0 && Bits <= 16) && ...), "slots are 1 to 16 bits wide");
+	static_assert(totalBits <= 64, "all the slots have to fit in 64 bits");
+
+	// Smallest unsigned type that holds every slot.
+	using Word = std::conditional_t<totalBits <= 8, std::uint8_t,
+		std::conditional_t<totalBits <= 16, std::uint16_t,
+		std::conditional_t<totalBits <= 32, std::uint32_t, std::uint64_t>>>;
+
+private:
+	static constexpr std::array<int, itemCount> makeShifts()
+	{
+		std::array<int, itemCount> shifts{};
+		int shift{ 0 };
+		for (int i{ 0 }; i < itemCount; ++i)
+		{
+			shifts[i] = shift;
+			shift += widths[i];
+		}
+		return shifts;
+	}
+
+	static constexpr std::array<int, itemCount> shifts{ makeShifts() };
+
+	Word m_bits{ 0 };
+
+public:
+	static constexpr int max(int item) { return (1 << widths[item]) - 1; }
+
+	constexpr int count(int item) const
+	{
+		return static_cast<int>((m_bits >> shifts[item]) & static_cast<Word>(max(item)));
+	}
+
+	// Adds up to amount(stopping at max(item)) and returns how many were actually added.
+	// amount must not be negative, use remove() to take items away. A negative amount adds nothing(and asserts in debug builds).
+	constexpr int add(int item, int amount = 1)
+	{
+		assert(amount >= 0 && "use remove() to take items away");
+		if (amount <= 0)
+			return 0;
+		const int current{ count(item) };
+		const int added{ amount < max(item) - current ? amount : max(item) - current };
+		m_bits = static_cast<Word>(m_bits + (static_cast<Word>(added) << shifts[item]));
+		return added;
+	}
+
+	// Removes up to amount(stopping at 0) and returns how many were actually removed.
+	// Like add(), a negative amount removes nothing.
+	constexpr int remove(int item, int amount = 1)
+	{
+		assert(amount >= 0 && "use add() to put items back");
+		if (amount <= 0)
+			return 0;
+		const int current{ count(item) };
+		const int removed{ amount < current ? amount : current };
+		m_bits = static_cast<Word>(m_bits - (static_cast<Word>(removed) << shifts[item]));
+		return removed;
+	}
+
+	constexpr int total() const
+	{
+		int sum{ 0 };
+		for (int item{ 0 }; item < itemCount; ++item)
+			sum += count(item);
+		return sum;
+	}
+
+	constexpr Word raw() const { return m_bits; }
+
+	// Inverse of raw(), for inventories read back from a file. Bits past totalBits are dropped.
+	static constexpr PackedInventory fromRaw(Word bits)
+	{
+		PackedInventory inventory{};
+		if constexpr (totalBits < static_cast<int>(sizeof(Word) * 8))
+			bits = static_cast<Word>(bits & ((Word{ 1 } << totalBits) - 1));
+		inventory.m_bits = bits;
+		return inventory;
+	}
+
+	// Total number of items across every inventory in the span.
+	static std::uint64_t countAll(std::span<const PackedInventory> inventories)
+	{
+		static_assert(sizeof(PackedInventory) == sizeof(Word), "inventories have to be packed back to back");
+		const auto* bytes{ reinterpret_cast<const unsigned char*>(inventories.data()) };
+		const std::size_t byteCount{ inventories.size_bytes() };
+
+		// Unused high bits are always 0, so they don't change either sum.
+		if constexpr (((Bits == 8) && ...))
+			return PackedInventoryKernels::sumBytes(bytes, byteCount);
+		else if constexpr (((Bits == 1) && ...))
+			return PackedInventoryKernels::popcountBytes(bytes, byteCount);
+		else
+		{
+			std::uint64_t sum{ 0 };
+			for (int item{ 0 }; item < itemCount; ++item)
+			{
+				const int shift{ shifts[item] };
+				const auto mask{ static_cast<Word>(max(item)) };
+				for (const PackedInventory& inventory : inventories)
+					sum += (inventory.m_bits >> shift) & mask;
+			}
+			return sum;
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Helpers for splitting a big job into pieces and running the pieces on several threads.
+namespace Parallel
+{
+	// Number of threads to use when the caller doesn't care. hardware_concurrency() is allowed to return 0.
+	inline int defaultThreadCount()
+	{
+		const unsigned int threads{ std::thread::hardware_concurrency() };
+		return threads == 0 ? 1 : static_cast<int>(threads);
+	}
+
+	// Calls work(index, threadIndex) once for every index in [0, count), using up to threadCount threads.
+	// threadIndex is in [0, threadCount) and can be used to pick per-thread scratch space.
+	// Indices aren't split up ahead of time, each thread grabs the next unclaimed one when it finishes the last.
+	// So if some pieces take longer than others, the idle threads just pick up more pieces.
+	// The calling thread does work too(as threadIndex 0), and forEachIndex returns once every index is done.
+	template <typename Work>
+	void forEachIndex(std::size_t count, int threadCount, Work&& work)
+	{
+		if (threadCount < 1)
+			threadCount = 1;
+		if (static_cast<std::size_t>(threadCount) > count)
+			threadCount = static_cast<int>(count);
+
+		std::atomic<std::size_t> next{ 0 };
+		auto worker{ [&](int threadIndex) {
+			for (std::size_t index{ next.fetch_add(1, std::memory_order_relaxed) }; index < count;
+				index = next.fetch_add(1, std::memory_order_relaxed))
+			{
+				work(index, threadIndex);
+			}
+		} };
+
+		std::vector<std::thread> threads{};
+		threads.reserve(threadCount > 0 ? threadCount - 1 : 0);
+		for (int i{ 1 }; i < threadCount; ++i)
+			threads.emplace_back(worker, i);
+
+		if (threadCount > 0)
+			worker(0);
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+// Turning a string back into an enumerator(13.4, 17.6) is usually done by comparing the input against every name.
+// PerfectHash::Table does it with one hash and one compare instead: at compile time it searches for a seed that sends
+// every name to its own slot, so a lookup is hash -> slot -> compare against the one name that could match.
+//
+//	constexpr PerfectHash::Table<Color::Type, Color::max_colors> colorTable{ Color::colorName };
+//	std::optional<Color::Type> color{ colorTable.fromString("red") };
+//
+// Names have to be listed in enumerator order(name[i] is enumerator i), like the 17.6 arrays already are.
+namespace PerfectHash
+{
+	// Only looks at the length and the first, middle and last characters, so hashing costs the same for any name
+	// and has no loop. That is enough to tell enum names apart, and fromString() always checks the whole string anyway.
+	constexpr std::uint32_t hash(std::string_view text, std::uint32_t seed)
+	{
+		const std::size_t length{ text.size() };
+		std::uint32_t h{ seed ^ static_cast<std::uint32_t>(length) * 0x9E3779B1u };
+		if (length > 0)
+		{
+			h = (h ^ static_cast<unsigned char>(text[0])) * 0x01000193u;
+			h = (h ^ static_cast<unsigned char>(text[length / 2])) * 0x01000193u;
+			h = (h ^ static_cast<unsigned char>(text[length - 1])) * 0x01000193u;
+		}
+		return h ^ (h >> 15);
+	}
+
+	template <typename Enum, std::size_t N>
+	class Table
+	{
+	private:
+		// 4 slots per name keeps the seed search short. Enums are small, so this is only a few dozen bytes.
+		static constexpr std::size_t slotCount{ std::bit_ceil(N * 4) };
+		static constexpr std::uint32_t maxSeed{ 1 << 16 };
+
+		std::array<std::string_view, N> m_names{};
+		std::array<std::uint8_t, slotCount> m_slots{}; // index + 1 into m_names, 0 means empty
+		std::uint32_t m_seed{};
+
+		static_assert(N < 255, "PerfectHash::Table stores indices in a byte");
+
+		constexpr bool tryBuild(std::uint32_t seed)
+		{
+			m_slots = {};
+			for (std::size_t i{ 0 }; i < N; ++i)
+			{
+				std::uint8_t& slot{ m_slots[hash(m_names[i], seed) & (slotCount - 1)] };
+				if (slot != 0)
+					return false;
+				slot = static_cast<std::uint8_t>(i + 1);
+			}
+			m_seed = seed;
+			return true;
+		}
+
+	public:
+		// Finds the seed. In a constexpr this happens while compiling. If two names only differ in characters the hash
+		// doesn't look at(same length, first, middle and last character) no seed works, and the build fails here.
+		constexpr explicit Table(const std::array<std::string_view, N>& names)
+			: m_names{ names }
+		{
+			for (std::uint32_t seed{ 0 }; seed < maxSeed; ++seed)
+			{
+				if (tryBuild(seed))
+					return;
+			}
+			throw std::logic_error{ "PerfectHash::Table: no seed separates these names" };
+		}
+
+		constexpr std::optional<Enum> fromString(std::string_view text) const
+		{
+			const std::uint8_t slot{ m_slots[hash(text, m_seed) & (slotCount - 1)] };
+			// Empty slots hold 0, and the name at 0 is never compared against because of the first check.
+			if (slot == 0 || m_names[slot - 1] != text)
+				return std::nullopt;
+			return static_cast<Enum>(slot - 1);
+		}
+
+		constexpr std::uint32_t seed() const { return m_seed; }
+	};
+
+	// Pulls the name member out of an array of structs, for tables like Animal::data:
+	//	constexpr PerfectHash::Table<Animal::Type, Animal::max_animals> animalTable{ PerfectHash::names(Animal::data, &Animal::Data::name) };
+	template <typename T, std::size_t N>
+	constexpr std::array<std::string_view, N> names(const std::array<T, N>& data, std::string_view T::* member)
+	{
+		std::array<std::string_view, N> result{};
+		for (std::size_t i{ 0 }; i < N; ++i)
+			result[i] = data[i].*member;
+		return result;
+	}
+}
+
+#endif
@@ -0,0 +1,27 @@
+#include "Player.h"
+#include "Random.h"
+
+Player::Player(std::string_view name, allocator_type alloc)
+	: m_name{ name, alloc }, m_gold{ Random::get(80, 120) }
+{ }
+
+Player::Player(std::string_view name, int gold, const PotionInventory& inventory, allocator_type alloc)
+	: m_name{ name, alloc }, m_gold{ gold }, m_inventory{ inventory }
+{ }
+
+Player::Player(const Player& other, allocator_type alloc)
+	: m_name{ other.m_name, alloc }, m_gold{ other.m_gold }, m_inventory{ other.m_inventory }
+{ }
+
+Player::Player(Player&& other, allocator_type alloc)
+	: m_name{ std::move(other.m_name), alloc }, m_gold{ other.m_gold }, m_inventory{ other.m_inventory }
+{ }
+
+bool Player::buy(Potion::Type type)
+{
+	if (m_gold < Potion::costs[type] || m_inventory.count(type) == PotionInventory::max(type))
+		return false;
+	setGold(Potion::costs[type]);
+	m_inventory.add(type);
+	return true;
+}
@@ -0,0 +1,54 @@
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "PackedInventory.h"
+#include "Potion.h"
+
+//One byte per potion type(up to 255 of each) instead of an int, 4 bytes per player instead of 16.
+using PotionInventory = PackedInventory<8, 8, 8, 8>;
+static_assert(PotionInventory::itemCount == Potion::max_types);
+
+//17.x Q2 player, moved out of 15.1-17.x.cpp.
+//Player is allocator aware: the name can come from any std::pmr::memory_resource (like a FrameArena)
+//instead of the global heap. Containers like std::pmr::vector<Player> pass their allocator on automatically.
+class Player {
+public:
+	using allocator_type = std::pmr::polymorphic_allocator<>;
+
+private:
+	std::pmr::string m_name{};
+	int m_gold{};
+	PotionInventory m_inventory{};
+
+public:
+	Player(std::string_view name, allocator_type alloc = {});
+	//Player with known gold and potions, e.g. loaded back from a PlayerStore.
+	Player(std::string_view name, int gold, const PotionInventory& inventory, allocator_type alloc = {});
+
+	//Copy/move into a different allocator, used by pmr containers.
+	Player(const Player& other, allocator_type alloc);
+	Player(Player&& other, allocator_type alloc);
+	Player(const Player&) = default;
+	Player(Player&&) = default;
+	Player& operator=(const Player&) = default;
+	Player& operator=(Player&&) = default;
+
+	allocator_type get_allocator() const { return m_name.get_allocator(); }
+
+	std::string_view getName() const { return m_name; }
+	int getGold() const { return m_gold; }
+	//Takes cost gold away and returns what's left. This used to return m_gold - cost without changing m_gold.
+	int setGold(int cost) { m_gold -= cost; return m_gold; }
+	//Pays for one potion and adds it to the inventory. Does nothing and returns false if there isn't enough gold
+	//or the player already has PotionInventory::max() of that potion.
+	bool buy(Potion::Type type);
+	int inventory(Potion::Type index) const { return m_inventory.count(index); }
+	const PotionInventory& getInventory() const { return m_inventory; }
+};
+
+#endif
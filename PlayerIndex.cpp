@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#include "PlayerIndex.h"
+
+// Same check as PackedInventory.cpp: SSE2 is always there on x64, anything else uses the plain loops.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLAYERINDEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// Control byte values. Both special ones have the high bit set, hash bytes never do.
+	constexpr std::int8_t empty{ -128 };	// 0x80
+	constexpr std::int8_t deleted{ -2 };	// 0xFE
+
+	std::int8_t hashByte(std::uint64_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+	std::size_t hashGroup(std::uint64_t hash) { return static_cast<std::size_t>(hash >> 7); }
+
+	// Bit i is set if control byte i of the group equals value.
+	std::uint32_t match(const std::int8_t* group, std::int8_t value)
+	{
+#ifdef PLAYERINDEX_SSE2
+		const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)) };
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+		std::uint32_t bits{ 0 };
+		for (std::size_t i{ 0 }; i < PlayerIndex::groupWidth; ++i)
+			bits |= static_cast<std::uint32_t>(group[i] == value) << i;
+		return bits;
+#endif
+	}
+
+	// Bit i is set if control byte i is empty or deleted, which is just its high bit.
+	std::uint32_t matchFree(const std::int8_t* group)
+	{
+#ifdef PLAYERINDEX_SSE2
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+		std::uint32_t bits{ 0 };
+		for (std::size_t i{ 0 }; i < PlayerIndex::groupWidth; ++i)
+			bits |= static_cast<std::uint32_t>(group[i] < 0) << i;
+		return bits;
+#endif
+	}
+
+	// Tables are kept at most 7/8 full(counting deleted entries), probe sequences stay short.
+	bool tooFull(std::size_t used, std::size_t capacity) { return used * 8 > capacity * 7; }
+}
+
+std::uint64_t PlayerIndex::hash(std::string_view name)
+{
+	// 8 bytes per multiply instead of FNV-1a's 1, names like "Wandering adventurer 123" hash about 4x faster.
+	std::uint64_t hash{ 0x9e3779b97f4a7c15ull ^ name.size() };
+	std::size_t i{ 0 };
+	for (; i + sizeof(std::uint64_t) <= name.size(); i += sizeof(std::uint64_t))
+	{
+		std::uint64_t word{};
+		std::memcpy(&word, name.data() + i, sizeof(word));
+		hash = (hash ^ word) * 0xbf58476d1ce4e5b9ull;
+		hash ^= hash >> 29;
+	}
+	if (i < name.size())
+	{
+		std::uint64_t word{ 0 };
+		std::memcpy(&word, name.data() + i, name.size() - i);
+		hash = (hash ^ word) * 0xbf58476d1ce4e5b9ull;
+		hash ^= hash >> 29;
+	}
+
+	// Mix once more so the low 7 bits(control bytes) and the high bits(group) both depend on every byte.
+	hash ^= hash >> 32;
+	hash *= 0xd6e8feb86659fd93ull;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+std::ptrdiff_t PlayerIndex::findPosition(std::string_view name, std::uint64_t hash) const
+{
+	if (m_entries.empty())
+		return -1;
+
+	const std::int8_t h2{ hashByte(hash) };
+	std::size_t group{ hashGroup(hash) & m_groupMask };
+	// Groups are visited 0, +1, +3, +6, ... apart, which reaches every group when the group count is a power of 2.
+	for (std::size_t step{ 1 };; group = (group + step++) & m_groupMask)
+	{
+		const std::int8_t* control{ m_control.data() + group * groupWidth };
+		for (std::uint32_t bits{ match(control, h2) }; bits != 0; bits &= bits - 1)
+		{
+			const std::size_t position{ group * groupWidth + static_cast<std::size_t>(std::countr_zero(bits)) };
+			const Entry& entry{ m_entries[position] };
+			if (entry.hash == hash && this->name(entry) == name)
+				return static_cast<std::ptrdiff_t>(position);
+		}
+		// An empty spot means the name would have been put here if it were in the table.
+		if (match(control, empty) != 0)
+			return -1;
+	}
+}
+
+std::optional<std::uint32_t> PlayerIndex::find(std::string_view name) const
+{
+	const std::ptrdiff_t position{ findPosition(name, hash(name)) };
+	if (position < 0)
+		return std::nullopt;
+	return m_entries[static_cast<std::size_t>(position)].slot;
+}
+
+void PlayerIndex::place(const Entry& entry)
+{
+	std::size_t group{ hashGroup(entry.hash) & m_groupMask };
+	for (std::size_t step{ 1 };; group = (group + step++) & m_groupMask)
+	{
+		std::int8_t* control{ m_control.data() + group * groupWidth };
+		if (const std::uint32_t free{ matchFree(control) }; free != 0)
+		{
+			const int index{ std::countr_zero(free) };
+			if (control[index] == deleted)
+				--m_deleted;
+			control[index] = hashByte(entry.hash);
+			m_entries[group * groupWidth + static_cast<std::size_t>(index)] = entry;
+			return;
+		}
+	}
+}
+
+void PlayerIndex::rehash(std::size_t entries)
+{
+	std::size_t capacity{ groupWidth };
+	while (tooFull(entries, capacity))
+		capacity *= 2;
+
+	const std::vector<std::int8_t> oldControl{ std::exchange(m_control, std::vector<std::int8_t>(capacity, empty)) };
+	const std::vector<Entry> oldEntries{ std::exchange(m_entries, std::vector<Entry>(capacity)) };
+	const std::string oldNames{ std::exchange(m_names, std::string{}) };
+	m_names.reserve(oldNames.size());
+	m_groupMask = capacity / groupWidth - 1;
+	m_deleted = 0;
+
+	// Stored hashes mean no name gets hashed again. Names are copied over in the same pass,
+	// which leaves behind the ones that were erased.
+	for (std::size_t i{ 0 }; i < oldEntries.size(); ++i)
+	{
+		if (oldControl[i] < 0)
+			continue;
+		Entry entry{ oldEntries[i] };
+		const std::string_view name{ std::string_view{ oldNames }.substr(entry.nameOffset, entry.nameLength) };
+		entry.nameOffset = static_cast<std::uint32_t>(m_names.size());
+		m_names.append(name);
+		place(entry);
+	}
+}
+
+void PlayerIndex::reserve(std::size_t names)
+{
+	if (tooFull(names, capacity()))
+		rehash(names);
+}
+
+bool PlayerIndex::insert(std::string_view name, std::uint32_t slot)
+{
+	const std::uint64_t hash{ PlayerIndex::hash(name) };
+	if (findPosition(name, hash) >= 0)
+		return false;
+
+	if (tooFull(m_size + m_deleted + 1, capacity()))
+		rehash(std::max(m_size + 1, capacity() / 2)); // if it's mostly deleted entries this just cleans them out
+
+	place(Entry{ hash, static_cast<std::uint32_t>(m_names.size()), static_cast<std::uint32_t>(name.size()), slot });
+	m_names.append(name);
+	++m_size;
+	return true;
+}
+
+bool PlayerIndex::erase(std::string_view name)
+{
+	const std::ptrdiff_t position{ findPosition(name, hash(name)) };
+	if (position < 0)
+		return false;
+
+	// If the group still has an empty spot, any lookup reaching it stops here anyway, so the spot can be marked
+	// empty too. Otherwise it has to be marked deleted so lookups keep going past it.
+	const auto index{ static_cast<std::size_t>(position) };
+	const std::int8_t* group{ m_control.data() + index / groupWidth * groupWidth };
+	if (match(group, empty) != 0)
+		m_control[index] = empty;
+	else
+	{
+		m_control[index] = deleted;
+		++m_deleted;
+	}
+	--m_size;
+	return true;
+}
@@ -0,0 +1,73 @@
+#ifndef PLAYERINDEX_H
+#define PLAYERINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Finds a player by name. Maps each name to a slot number, which is whatever the caller uses to get at the player:
+// an index into a std::vector<Player>, a PlayerStore::PlayerId, etc.
+//
+// It's an open addressing table laid out like Google's Swiss tables. Next to the entries is an array of control
+// bytes, one per entry: either "empty", "deleted", or 7 bits of the name's hash. Entries are looked at in groups
+// of 16, and with SSE2 one compare checks all 16 control bytes of a group against the hash bits at once. Only the
+// entries whose 7 bits match(usually just the right one) get their full stored hash and then the name compared.
+// Probing goes group by group, so a lookup usually touches one group of control bytes and one entry.
+//
+// Lookups take a std::string_view and never build a std::string. Names are copied into the index's own buffer.
+class PlayerIndex
+{
+public:
+	static constexpr std::size_t groupWidth = 16;
+
+private:
+	struct Entry
+	{
+		std::uint64_t hash{};
+		std::uint32_t nameOffset{};	// into m_names
+		std::uint32_t nameLength{};
+		std::uint32_t slot{};
+	};
+
+	std::vector<std::int8_t> m_control{};	// one byte per entry, entry count is a multiple of groupWidth
+	std::vector<Entry> m_entries{};
+	std::string m_names{};
+	std::size_t m_groupMask{ 0 };
+	std::size_t m_size{ 0 };
+	std::size_t m_deleted{ 0 };
+
+	std::string_view name(const Entry& entry) const { return std::string_view{ m_names }.substr(entry.nameOffset, entry.nameLength); }
+	// Position of name in m_entries, or -1 if it isn't there.
+	std::ptrdiff_t findPosition(std::string_view name, std::uint64_t hash) const;
+	// Rebuilds the table with room for at least entries entries(and drops the names of erased players).
+	void rehash(std::size_t entries);
+	// Puts an entry in the first free spot along hash's probe sequence. The name must already be in m_names.
+	void place(const Entry& entry);
+
+public:
+	PlayerIndex() = default;
+
+	// Makes room for this many names without growing again.
+	void reserve(std::size_t names);
+
+	// Returns false and changes nothing if the name is already in the index.
+	bool insert(std::string_view name, std::uint32_t slot);
+
+	std::optional<std::uint32_t> find(std::string_view name) const;
+	bool contains(std::string_view name) const { return find(name).has_value(); }
+
+	// Returns false if the name wasn't in the index.
+	bool erase(std::string_view name);
+
+	std::size_t size() const { return m_size; }
+	std::size_t capacity() const { return m_entries.size(); }
+
+	// Hashes the name 8 bytes at a time. The same name always gives the same hash, but only within one build
+	// (it depends on the machine's byte order), so don't save it to a file.
+	static std::uint64_t hash(std::string_view name);
+};
+
+#endif
@@ -0,0 +1,354 @@
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <system_error>
+#include <type_traits>
+
+#include "MappedFile.h"
+#include "PlayerStore.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+	constexpr std::array<char, 4> snapshotMagic{ 'P', 'S', 'N', 'P' };
+	constexpr std::uint32_t snapshotVersion{ 1 };
+
+	//Followed by gold[players], inventory[players], nameOffsets[players + 1] and textBytes of names.
+	struct SnapshotHeader {
+		std::array<char, 4> magic{};
+		std::uint32_t version{};
+		std::uint32_t players{};
+		std::uint32_t textBytes{};
+	};
+
+	//One change in the log, followed by nameLength bytes of name. A record for the next unused id adds a player,
+	//any other id updates one.
+	struct LogRecord {
+		std::uint32_t checksum{};
+		std::uint32_t player{};
+		std::int32_t gold{};
+		std::uint32_t inventory{};
+		std::uint32_t nameLength{};
+	};
+	static_assert(sizeof(LogRecord) == 20 && std::is_trivially_copyable_v<LogRecord>);
+	static_assert(sizeof(PotionInventory::Word) <= sizeof(LogRecord::inventory));
+
+	//FNV-1a over everything after the checksum field. Catches a record that was only partly written before a crash.
+	std::uint32_t checksum(const LogRecord& record, std::string_view name) {
+		std::uint32_t hash{ 2166136261u };
+		auto mix{ [&hash](const char* bytes, std::size_t count) {
+			for (std::size_t i{ 0 }; i < count; ++i)
+				hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 16777619u;
+		} };
+		mix(reinterpret_cast<const char*>(&record) + sizeof(record.checksum), sizeof(record) - sizeof(record.checksum));
+		mix(name.data(), name.size());
+		return hash;
+	}
+
+	//Flushes the FILE's buffer and makes the OS put the file on disk.
+	bool syncFile(std::FILE* file) {
+		if (std::fflush(file) != 0)
+			return false;
+#ifdef _WIN32
+		return _commit(_fileno(file)) == 0;
+#else
+		return fsync(fileno(file)) == 0;
+#endif
+	}
+
+	template <typename T>
+	const char* copyArray(const char* in, std::vector<T>& out, std::size_t count) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		out.resize(count);
+		std::memcpy(out.data(), in, count * sizeof(T));
+		return in + count * sizeof(T);
+	}
+
+	template <typename T>
+	void writeArray(std::FILE* file, const T* data, std::size_t count) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		std::fwrite(data, sizeof(T), count, file);
+	}
+
+	const char* const snapshotName{ "players.snapshot" };
+	const char* const logName{ "players.wal" };
+}
+
+PlayerStore::PlayerStore(const std::filesystem::path& directory, const Options& options)
+	: m_directory{ directory }, m_options{ options }
+{ }
+
+PlayerStore::~PlayerStore() {
+	if (m_log) {
+		sync();
+		std::fclose(m_log);
+	}
+}
+
+std::unique_ptr<PlayerStore> PlayerStore::open(const std::filesystem::path& directory, const Options& options) {
+	std::error_code error{};
+	std::filesystem::create_directories(directory, error);
+
+	std::unique_ptr<PlayerStore> store{ new PlayerStore{ directory, options } };
+	if (!store->loadSnapshot())
+		return nullptr;
+
+	if (store->replayLog()) {
+		store->m_log = std::fopen((directory / logName).string().c_str(), "ab");
+		if (!store->m_log)
+			return nullptr;
+	}
+	else {
+		//The log has garbage after the last good change. Appending after it would leave the garbage in the middle,
+		//so save what we have as a snapshot, which also starts a fresh log.
+		std::lock_guard lock{ store->m_mutex };
+		if (!store->snapshotLocked())
+			return nullptr;
+	}
+	return store;
+}
+
+bool PlayerStore::loadSnapshot() {
+	const std::filesystem::path path{ m_directory / snapshotName };
+	std::error_code error{};
+	if (!std::filesystem::exists(path, error))
+		return true; //new store
+
+	const MappedFile file{ path };
+	SnapshotHeader header{};
+	if (file.size() < sizeof(header))
+		return false;
+	std::memcpy(&header, file.data(), sizeof(header));
+
+	//Same as MonsterCatalog: the sizes in the header have to add up to the file size.
+	const unsigned long long players{ header.players };
+	if (header.magic != snapshotMagic || header.version != snapshotVersion
+		|| file.size() != sizeof(header) + players * sizeof(std::int32_t) + players * sizeof(PotionInventory::Word)
+			+ (players + 1) * sizeof(std::uint32_t) + header.textBytes)
+		return false;
+
+	const char* in{ file.data() + sizeof(header) };
+	in = copyArray(in, m_gold, header.players);
+	in = copyArray(in, m_inventory, header.players);
+	in = copyArray(in, m_nameOffsets, header.players + 1);
+	m_names.assign(in, header.textBytes);
+
+	for (std::size_t i{ 0 }; i < header.players; ++i) {
+		if (m_nameOffsets[i] > m_nameOffsets[i + 1])
+			return false;
+	}
+	return m_nameOffsets.front() == 0 && m_nameOffsets.back() == header.textBytes;
+}
+
+bool PlayerStore::replayLog() {
+	std::FILE* file{ std::fopen((m_directory / logName).string().c_str(), "rb") };
+	if (!file)
+		return true; //no log yet
+
+	std::fseek(file, 0, SEEK_END);
+	const long size{ std::ftell(file) };
+	std::rewind(file);
+	std::vector<char> contents(size > 0 ? static_cast<std::size_t>(size) : 0);
+	const bool readAll{ std::fread(contents.data(), 1, contents.size(), file) == contents.size() };
+	std::fclose(file);
+	if (!readAll)
+		return false;
+
+	std::size_t pos{ 0 };
+	while (contents.size() - pos >= sizeof(LogRecord)) {
+		LogRecord record{};
+		std::memcpy(&record, contents.data() + pos, sizeof(record));
+		if (record.nameLength > contents.size() - pos - sizeof(record))
+			break;
+		const std::string_view name{ contents.data() + pos + sizeof(record), record.nameLength };
+		if (record.checksum != checksum(record, name) || record.player > m_gold.size())
+			break;
+
+		apply(record.player, record.gold, static_cast<PotionInventory::Word>(record.inventory), name);
+		pos += sizeof(record) + record.nameLength;
+	}
+
+	m_logBytes = pos;
+	return pos == contents.size();
+}
+
+void PlayerStore::apply(PlayerId id, std::int32_t gold, PotionInventory::Word inventory, std::string_view name) {
+	if (id == m_gold.size()) {
+		m_gold.push_back(gold);
+		m_inventory.push_back(inventory);
+		m_names.append(name);
+		m_nameOffsets.push_back(static_cast<std::uint32_t>(m_names.size()));
+	}
+	else {
+		m_gold[id] = gold;
+		m_inventory[id] = inventory;
+	}
+}
+
+PlayerStore::Lsn PlayerStore::append(PlayerId id, std::string_view name) {
+	LogRecord record{ 0, id, m_gold[id], m_inventory[id], static_cast<std::uint32_t>(name.size()) };
+	record.checksum = checksum(record, name);
+
+	const std::size_t start{ m_pending.size() };
+	m_pending.resize(start + sizeof(record) + name.size());
+	std::memcpy(m_pending.data() + start, &record, sizeof(record));
+	if (!name.empty()) //updates pass a default string_view, memcpy from nullptr isn't allowed even for 0 bytes
+		std::memcpy(m_pending.data() + start + sizeof(record), name.data(), name.size());
+	return ++m_lastLsn;
+}
+
+PlayerStore::PlayerId PlayerStore::add(const Player& player) {
+	return add(player.getName(), player.getGold(), player.getInventory());
+}
+
+PlayerStore::PlayerId PlayerStore::add(std::string_view name, int gold, const PotionInventory& inventory) {
+	std::lock_guard lock{ m_mutex };
+	const auto id{ static_cast<PlayerId>(m_gold.size()) };
+	apply(id, gold, inventory.raw(), name);
+	append(id, name);
+	return id;
+}
+
+PlayerStore::Lsn PlayerStore::update(PlayerId id, const Player& player) {
+	return update(id, player.getGold(), player.getInventory());
+}
+
+PlayerStore::Lsn PlayerStore::update(PlayerId id, int gold, const PotionInventory& inventory) {
+	std::lock_guard lock{ m_mutex };
+	//apply() would add a nameless player for id == size() and write past the end for anything bigger.
+	assert(id < m_gold.size() && "update() of a player that doesn't exist");
+	if (id >= m_gold.size())
+		return 0;
+	apply(id, gold, inventory.raw(), {});
+	return append(id, {});
+}
+
+bool PlayerStore::sync(Lsn lsn) {
+	std::unique_lock lock{ m_mutex };
+	if (lsn > m_lastLsn)
+		lsn = m_lastLsn;
+
+	//A snapshot that couldn't reopen the log leaves nothing to write to.
+	if (!m_log)
+		m_failed = true;
+
+	while (!m_failed && m_durableLsn < lsn) {
+		//Someone else is writing a batch. It might have our change in it, if not we write the next batch ourselves.
+		if (m_flushing) {
+			m_flushed.wait(lock);
+			continue;
+		}
+
+		//Take everything buffered so far(not just up to lsn) and write it without holding the lock,
+		//so other threads can keep adding changes for the next batch meanwhile.
+		m_flushing = true;
+		m_writing.swap(m_pending);
+		const Lsn batchEnd{ m_lastLsn };
+		lock.unlock();
+
+		const bool ok{ std::fwrite(m_writing.data(), 1, m_writing.size(), m_log) == m_writing.size() && syncFile(m_log) };
+
+		lock.lock();
+		m_logBytes += m_writing.size();
+		m_writing.clear();
+		++m_syncs;
+		if (ok) {
+			m_durableLsn = batchEnd;
+			if (m_logBytes >= m_options.snapshotLogBytes && !snapshotLocked())
+				m_failed = true;
+		}
+		else
+			m_failed = true;
+		m_flushing = false;
+		m_flushed.notify_all();
+	}
+	return !m_failed;
+}
+
+bool PlayerStore::sync() {
+	Lsn last{};
+	{
+		std::lock_guard lock{ m_mutex };
+		last = m_lastLsn;
+	}
+	return sync(last);
+}
+
+bool PlayerStore::snapshot() {
+	std::unique_lock lock{ m_mutex };
+	m_flushed.wait(lock, [this] { return !m_flushing; });
+	const bool ok{ snapshotLocked() };
+	if (!ok)
+		m_failed = true; //same as a failed sync(), the log might not be there anymore
+	m_flushed.notify_all();
+	return ok;
+}
+
+bool PlayerStore::snapshotLocked() {
+	const std::filesystem::path path{ m_directory / snapshotName };
+	std::filesystem::path temp{ path };
+	temp += ".tmp";
+
+	std::FILE* file{ std::fopen(temp.string().c_str(), "wb") };
+	if (!file)
+		return false;
+
+	const SnapshotHeader header{ snapshotMagic, snapshotVersion, static_cast<std::uint32_t>(m_gold.size()),
+		static_cast<std::uint32_t>(m_names.size()) };
+	writeArray(file, &header, 1);
+	writeArray(file, m_gold.data(), m_gold.size());
+	writeArray(file, m_inventory.data(), m_inventory.size());
+	writeArray(file, m_nameOffsets.data(), m_nameOffsets.size());
+	writeArray(file, m_names.data(), m_names.size());
+	const bool written{ !std::ferror(file) && syncFile(file) };
+	if (std::fclose(file) != 0 || !written)
+		return false;
+
+	//Only replace the old snapshot once the new one is completely on disk. If we crash before the log is emptied
+	//below, the log gets replayed on top of the new snapshot, which is harmless: every change stores the player's
+	//whole gold and inventory, so applying it twice gives the same result.
+	std::error_code error{};
+	std::filesystem::rename(temp, path, error);
+	if (error)
+		return false;
+
+	if (m_log)
+		std::fclose(m_log);
+	m_log = std::fopen((m_directory / logName).string().c_str(), "wb");
+	m_logBytes = 0;
+
+	//The snapshot has every change made so far, including ones still waiting in m_pending.
+	m_pending.clear();
+	m_durableLsn = m_lastLsn;
+	return m_log != nullptr;
+}
+
+std::size_t PlayerStore::size() const {
+	std::lock_guard lock{ m_mutex };
+	return m_gold.size();
+}
+
+Player PlayerStore::load(PlayerId id, Player::allocator_type alloc) const {
+	std::lock_guard lock{ m_mutex };
+	const std::string_view name{ std::string_view{ m_names }.substr(m_nameOffsets[id], m_nameOffsets[id + 1] - m_nameOffsets[id]) };
+	return Player{ name, m_gold[id], PotionInventory::fromRaw(m_inventory[id]), alloc };
+}
+
+int PlayerStore::gold(PlayerId id) const {
+	std::lock_guard lock{ m_mutex };
+	return m_gold[id];
+}
+
+PotionInventory PlayerStore::inventory(PlayerId id) const {
+	std::lock_guard lock{ m_mutex };
+	return PotionInventory::fromRaw(m_inventory[id]);
+}
+
+std::uint64_t PlayerStore::syncCount() const {
+	std::lock_guard lock{ m_mutex };
+	return m_syncs;
+}
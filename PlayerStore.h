@@ -0,0 +1,113 @@
+#ifndef PLAYERSTORE_H
+#define PLAYERSTORE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Player.h"
+
+// Players that survive a restart. Everything lives in one directory with two files:
+//	players.snapshot	every player as of some moment, as flat arrays(gold, inventory, name offsets, names)
+//	players.wal			write-ahead log: every change since that snapshot, appended to the end
+//
+// A change is applied in memory and added to the log buffer right away, but it is only on disk once sync() says so.
+// sync() is a group commit: whichever thread gets there first writes everything buffered so far with one fwrite and
+// one fsync, and every other thread waiting in sync() for a change in that batch just waits for it to finish. So 64
+// threads each saving a player and syncing cost one fsync, not 64.
+//
+// When the log gets bigger than Options::snapshotLogBytes, the next sync() writes a new snapshot(to a temp file,
+// then renamed over the old one) and starts an empty log, so the log never has to be replayed for long.
+// Opening maps the snapshot file and copies the arrays straight out of it, then replays the log. A log that ends
+// with a half written change(the program died mid write) is read up to the last complete change.
+//
+// Files use the machine's byte order, like MonsterCatalog's binary files. All member functions are thread safe.
+class PlayerStore {
+public:
+	using PlayerId = std::uint32_t;
+	// Log sequence number: the nth change made to the store. Pass it to sync() to wait until that change is on disk.
+	using Lsn = std::uint64_t;
+
+	struct Options {
+		std::size_t snapshotLogBytes{ 64 << 20 };
+	};
+
+private:
+	// Players are kept as columns, the same layout the snapshot file uses.
+	std::vector<std::int32_t> m_gold{};
+	std::vector<PotionInventory::Word> m_inventory{};
+	std::vector<std::uint32_t> m_nameOffsets{ 0 }; // player i's name is m_names[m_nameOffsets[i], m_nameOffsets[i + 1])
+	std::string m_names{};
+
+	std::filesystem::path m_directory{};
+	Options m_options{};
+	std::FILE* m_log{};
+	std::uint64_t m_logBytes{ 0 };
+
+	mutable std::mutex m_mutex{};
+	std::condition_variable m_flushed{};
+	std::vector<char> m_pending{};	// encoded changes not handed to the log file yet
+	std::vector<char> m_writing{};	// the batch being written, swapped with m_pending so neither reallocates
+	Lsn m_lastLsn{ 0 };
+	Lsn m_durableLsn{ 0 };
+	bool m_flushing{ false };
+	bool m_failed{ false };
+	std::uint64_t m_syncs{ 0 };
+
+	PlayerStore(const std::filesystem::path& directory, const Options& options);
+
+	bool loadSnapshot();
+	// Replays the log and returns false if it ended with a damaged or half written change.
+	bool replayLog();
+	void apply(PlayerId id, std::int32_t gold, PotionInventory::Word inventory, std::string_view name);
+	Lsn append(PlayerId id, std::string_view name);
+	// m_mutex has to be held and no flush can be in progress.
+	bool snapshotLocked();
+
+public:
+	~PlayerStore();
+
+	PlayerStore(const PlayerStore&) = delete;
+	PlayerStore& operator=(const PlayerStore&) = delete;
+
+	// Creates the directory if needed and loads whatever is in it. Returns nullptr if the files can't be opened
+	// or the snapshot is damaged.
+	static std::unique_ptr<PlayerStore> open(const std::filesystem::path& directory, const Options& options);
+	static std::unique_ptr<PlayerStore> open(const std::filesystem::path& directory) { return open(directory, Options{}); }
+
+	// Adds a player and returns its id. Ids are handed out in order starting at 0. Call sync() to make it durable.
+	PlayerId add(const Player& player);
+	PlayerId add(std::string_view name, int gold, const PotionInventory& inventory = {});
+
+	// Saves a player's gold and potions(the name can't change). id must be < size(), otherwise nothing changes
+	// and it returns 0(asserts in debug builds).
+	Lsn update(PlayerId id, const Player& player);
+	Lsn update(PlayerId id, int gold, const PotionInventory& inventory);
+
+	// Waits until every change up to lsn is on disk. Returns false if a write or fsync failed, after which the store
+	// stops accepting syncs(the log may be missing changes).
+	bool sync(Lsn lsn);
+	// sync() for every change made so far.
+	bool sync();
+
+	// Writes a snapshot and empties the log now instead of waiting for it to grow. If it fails the store stops
+	// accepting syncs, like a failed sync().
+	bool snapshot();
+
+	std::size_t size() const;
+	Player load(PlayerId id, Player::allocator_type alloc = {}) const;
+	int gold(PlayerId id) const;
+	PotionInventory inventory(PlayerId id) const;
+
+	// Number of times the log was fsynced, to see how well group commit is batching.
+	std::uint64_t syncCount() const;
+};
+
+#endif
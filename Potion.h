@@ -0,0 +1,26 @@
+#ifndef POTION_H
+#define POTION_H
+
+#include <array>
+#include <string_view>
+
+//17.x Q2 potions, moved out of 15.1-17.x.cpp so the shop/player code can share them.
+namespace Potion {
+	enum Type {
+		healing,
+		mana,
+		speed,
+		invisibility,
+		max_types,
+	};
+	constexpr std::array types{ healing, mana, speed, invisibility };
+
+	constexpr std::array<int, max_types> costs{ 20, 30, 12, 50 };
+	constexpr std::array<std::string_view, max_types> names{"healing", "mana", "speed", "invisibility"};
+	//Make sure the sizes of the arrays are accurate.
+	static_assert(std::size(types) == max_types);
+	static_assert(std::size(costs) == max_types);
+	static_assert(std::size(names) == max_types);
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef PRICETABLE_H
+#define PRICETABLE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "Potion.h"
+
+// Potion prices that can change while the game is running(an economy job raising and lowering them) while any
+// number of shop threads keep reading them.
+//
+// Same trick as Shop: every price fits in 16 bits, so while there are at most 4 potion types the whole table is
+// packed into one 64 bit word. Publishing a new table is a single atomic store and reading one is a single atomic
+// load, so a reader always gets all the prices from the same version, never half old and half new. Readers never
+// wait or retry, and old versions never need to be freed.
+//
+// With a 5th potion the table doesn't fit anymore, and it turns into a seqlock instead: a version number that is odd
+// while a writer is in the middle of a change. Readers still never lock, but they retry if the version changed under
+// them. Nothing outside this class has to change either way.
+//
+//	PriceTable prices{};				// starts at Potion::costs
+//	prices.set(Potion::mana, 35);		// economy thread
+//	int cost{ prices.price(Potion::mana) };	// any shop thread
+class PriceTable
+{
+public:
+	static constexpr int priceBits{ 16 };
+	static constexpr int maxPrice{ (1 << priceBits) - 1 };
+	// True when the table is one atomic word.
+	static constexpr bool packed{ Potion::max_types * priceBits <= 64 };
+
+	using Prices = std::array<int, Potion::max_types>;
+
+private:
+	// Prices are clamped to 0..maxPrice.
+	static constexpr int clamp(int price) { return std::clamp(price, 0, maxPrice); }
+
+	class Word
+	{
+		std::atomic<std::uint64_t> m_word{};
+
+		static constexpr std::uint64_t priceMask{ static_cast<std::uint64_t>(maxPrice) };
+
+		static constexpr int shift(Potion::Type type) { return type * priceBits; }
+
+		static constexpr std::uint64_t pack(const Prices& prices)
+		{
+			std::uint64_t word{ 0 };
+			for (const Potion::Type type : Potion::types)
+				word |= static_cast<std::uint64_t>(clamp(prices[type])) << shift(type);
+			return word;
+		}
+
+	public:
+		explicit Word(const Prices& prices)
+			: m_word{ pack(prices) }
+		{ }
+
+		int price(Potion::Type type) const
+		{
+			return static_cast<int>((m_word.load(std::memory_order_acquire) >> shift(type)) & priceMask);
+		}
+
+		Prices prices() const
+		{
+			const std::uint64_t word{ m_word.load(std::memory_order_acquire) };
+			Prices prices{};
+			for (const Potion::Type type : Potion::types)
+				prices[type] = static_cast<int>((word >> shift(type)) & priceMask);
+			return prices;
+		}
+
+		void publish(const Prices& prices) { m_word.store(pack(prices), std::memory_order_release); }
+
+		// If two writers change different prices at the same time, the CAS makes sure neither change is lost.
+		void set(Potion::Type type, int price)
+		{
+			const std::uint64_t bits{ static_cast<std::uint64_t>(clamp(price)) << shift(type) };
+			std::uint64_t word{ m_word.load(std::memory_order_relaxed) };
+			while (!m_word.compare_exchange_weak(word, (word & ~(priceMask << shift(type))) | bits,
+				std::memory_order_release, std::memory_order_relaxed))
+			{ }
+		}
+	};
+
+	class Versioned
+	{
+		std::atomic<std::uint64_t> m_version{ 0 }; // odd while a writer is changing m_prices
+		// Atomic so a reader racing a writer is a retry and not a data race, relaxed is enough for the prices
+		// themselves, m_version does the ordering.
+		std::array<std::atomic<int>, Potion::max_types> m_prices{};
+
+		// Writers take turns by moving the version from even to odd.
+		std::uint64_t beginWrite()
+		{
+			std::uint64_t version{ m_version.load(std::memory_order_relaxed) };
+			while ((version & 1) != 0 || !m_version.compare_exchange_weak(version, version + 1,
+				std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				version = m_version.load(std::memory_order_relaxed);
+			}
+			// The price stores below can't move up past the odd version.
+			std::atomic_thread_fence(std::memory_order_release);
+			return version;
+		}
+
+		void endWrite(std::uint64_t version) { m_version.store(version + 2, std::memory_order_release); }
+
+		// Calls read() until it ran without a writer getting in the way.
+		template <typename Read>
+		auto readConsistent(Read read) const
+		{
+			for (;;)
+			{
+				const std::uint64_t before{ m_version.load(std::memory_order_acquire) };
+				if ((before & 1) != 0)
+					continue;
+				auto result{ read() };
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (m_version.load(std::memory_order_relaxed) == before)
+					return result;
+			}
+		}
+
+	public:
+		explicit Versioned(const Prices& prices)
+		{
+			for (const Potion::Type type : Potion::types)
+				m_prices[type].store(clamp(prices[type]), std::memory_order_relaxed);
+		}
+
+		// One int can't be torn, so a single price doesn't need the version.
+		int price(Potion::Type type) const { return m_prices[type].load(std::memory_order_acquire); }
+
+		Prices prices() const
+		{
+			return readConsistent([this] {
+				Prices prices{};
+				for (const Potion::Type type : Potion::types)
+					prices[type] = m_prices[type].load(std::memory_order_relaxed);
+				return prices;
+			});
+		}
+
+		void publish(const Prices& prices)
+		{
+			const std::uint64_t version{ beginWrite() };
+			for (const Potion::Type type : Potion::types)
+				m_prices[type].store(clamp(prices[type]), std::memory_order_relaxed);
+			endWrite(version);
+		}
+
+		void set(Potion::Type type, int price)
+		{
+			const std::uint64_t version{ beginWrite() };
+			m_prices[type].store(clamp(price), std::memory_order_relaxed);
+			endWrite(version);
+		}
+	};
+
+	std::conditional_t<packed, Word, Versioned> m_table;
+
+public:
+	explicit PriceTable(const Prices& prices = Potion::costs)
+		: m_table{ prices }
+	{ }
+
+	PriceTable(const PriceTable&) = delete;
+	PriceTable& operator=(const PriceTable&) = delete;
+
+	// Readers. Wait-free while the table is packed, one atomic load each.
+	int price(Potion::Type type) const { return m_table.price(type); }
+
+	// Every price from the same version of the table.
+	Prices prices() const { return m_table.prices(); }
+
+	// Writers. Replaces the whole table at once.
+	void publish(const Prices& prices) { m_table.publish(prices); }
+
+	// Changes one price and keeps the rest. If two writers change different prices at the same time, neither change
+	// is lost.
+	void set(Potion::Type type, int price) { m_table.set(type, price); }
+};
+
+#endif
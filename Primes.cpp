@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+#include "Primes.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	// Maps n % 30 to its bit in a wheel byte, or -1 if n % 30 shares a factor with 30(so n can't be prime).
+	constexpr int bitIndex[Primes::wheelSize]{
+		-1, 0, -1, -1, -1, -1, -1, 1, -1, -1,
+		-1, 2, -1, 3, -1, -1, -1, 4, -1, 5,
+		-1, -1, -1, 6, -1, -1, -1, -1, -1, 7,
+	};
+
+	std::uint64_t integerSqrt(std::uint64_t n)
+	{
+		auto root{ static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n))) };
+		// The double can be off by one for big n, so fix it up.
+		while (root > 0 && root * root > n)
+			--root;
+		while ((root + 1) * (root + 1) <= n)
+			++root;
+		return root;
+	}
+
+	// (a * b) % m without overflowing. The product of two 64 bit numbers needs 128 bits.
+	std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, std::uint64_t m)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		std::uint64_t high{};
+		const std::uint64_t low{ _umul128(a, b, &high) };
+		std::uint64_t remainder{};
+		_udiv128(high, low, m, &remainder);
+		return remainder;
+#elif defined(__SIZEOF_INT128__)
+		return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+#else
+		// Double and add, slow but works everywhere.
+		std::uint64_t result{ 0 };
+		a %= m;
+		while (b > 0)
+		{
+			if (b & 1)
+				result = (result >= m - a) ? result - (m - a) : result + a;
+			a = (a >= m - a) ? a - (m - a) : a + a;
+			b >>= 1;
+		}
+		return result;
+#endif
+	}
+
+	std::uint64_t powMod(std::uint64_t base, std::uint64_t exponent, std::uint64_t m)
+	{
+		std::uint64_t result{ 1 };
+		base %= m;
+		while (exponent > 0)
+		{
+			if (exponent & 1)
+				result = mulMod(result, base, m);
+			base = mulMod(base, base, m);
+			exponent >>= 1;
+		}
+		return result;
+	}
+}
+
+namespace Primes
+{
+	std::vector<std::uint32_t> smallPrimes(std::uint32_t limit)
+	{
+		std::vector<char> composite(static_cast<std::size_t>(limit) + 1, false);
+		std::vector<std::uint32_t> primes{};
+
+		for (std::uint32_t i{ 2 }; i <= limit; ++i)
+		{
+			if (composite[i])
+				continue;
+			primes.push_back(i);
+			for (std::uint64_t j{ static_cast<std::uint64_t>(i) * i }; j <= limit; j += i)
+				composite[j] = true;
+		}
+		return primes;
+	}
+
+	void sieveSegment(std::uint64_t low, std::size_t bytes, const std::vector<std::uint32_t>& sievingPrimes, std::uint8_t* out)
+	{
+		std::fill(out, out + bytes, static_cast<std::uint8_t>(0xFF));
+		const std::uint64_t high{ low + static_cast<std::uint64_t>(wheelSize) * bytes };
+
+		for (const std::uint32_t p : sievingPrimes)
+		{
+			// 2, 3 and 5 aren't in the wheel, so there is nothing to cross off for them.
+			if (p < 7)
+				continue;
+			if (static_cast<std::uint64_t>(p) * p >= high)
+				break;
+
+			// Everything below p * p was already crossed off by a smaller prime.
+			const std::uint64_t kMin{ std::max<std::uint64_t>(p, (low + p - 1) / p) };
+
+			// p * k is only in the wheel when k is, so walk the 8 residues of k separately.
+			// Within one residue class, k += 30 moves p * k forward by exactly p bytes and keeps the same bit.
+			for (const int residue : wheelResidues)
+			{
+				const std::uint64_t k{ kMin + (residue - static_cast<int>(kMin % wheelSize) + wheelSize) % wheelSize };
+				const std::uint64_t multiple{ p * k };
+				const auto mask{ static_cast<std::uint8_t>(~(1u << bitIndex[multiple % wheelSize])) };
+
+				for (std::uint64_t byte{ (multiple - low) / wheelSize }; byte < bytes; byte += p)
+					out[byte] &= mask;
+			}
+		}
+
+		// 1 sits in the wheel but isn't prime.
+		if (low == 0 && bytes > 0)
+			out[0] &= static_cast<std::uint8_t>(~1u);
+	}
+
+	bool millerRabin(std::uint64_t n)
+	{
+		if (n < 2)
+			return false;
+		for (const std::uint64_t p : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 })
+		{
+			if (n % p == 0)
+				return n == p;
+		}
+
+		std::uint64_t d{ n - 1 };
+		int shifts{ 0 };
+		while ((d & 1) == 0)
+		{
+			d >>= 1;
+			++shifts;
+		}
+
+		// These 7 bases are enough to make the test exact for every n < 2^64 (Jim Sinclair, 2011).
+		for (std::uint64_t base : { 2ull, 325ull, 9375ull, 28178ull, 450775ull, 9780504ull, 1795265022ull })
+		{
+			base %= n;
+			if (base == 0)
+				continue;
+
+			std::uint64_t x{ powMod(base, d, n) };
+			if (x == 1 || x == n - 1)
+				continue;
+
+			bool composite{ true };
+			for (int i{ 1 }; i < shifts; ++i)
+			{
+				x = mulMod(x, x, n);
+				if (x == n - 1)
+				{
+					composite = false;
+					break;
+				}
+			}
+			if (composite)
+				return false;
+		}
+		return true;
+	}
+
+	Sieve::Sieve(std::uint64_t limit)
+		: m_limit{ limit }, m_bits(static_cast<std::size_t>(limit / wheelSize + 1))
+	{
+		const std::uint64_t high{ static_cast<std::uint64_t>(m_bits.size()) * wheelSize };
+		const std::vector<std::uint32_t> sievingPrimes{ smallPrimes(static_cast<std::uint32_t>(integerSqrt(high) + 1)) };
+
+		for (std::size_t start{ 0 }; start < m_bits.size(); start += segmentBytes)
+		{
+			const std::size_t bytes{ std::min(segmentBytes, m_bits.size() - start) };
+			sieveSegment(static_cast<std::uint64_t>(start) * wheelSize, bytes, sievingPrimes, m_bits.data() + start);
+		}
+	}
+
+	bool Sieve::isPrime(std::uint64_t n) const
+	{
+		if (n > m_limit)
+			return millerRabin(n);
+		if (n < 7)
+			return n == 2 || n == 3 || n == 5;
+
+		const int bit{ bitIndex[n % wheelSize] };
+		if (bit < 0)
+			return false;
+		return (m_bits[static_cast<std::size_t>(n / wheelSize)] >> bit) & 1;
+	}
+
+	bool isPrime(std::uint64_t n)
+	{
+		static const Sieve s_sieve{ defaultLimit };
+		return s_sieve.isPrime(n);
+	}
+
+	void forEachSegment(std::uint64_t lo, std::uint64_t hi, int threadCount,
+		const std::function<void(std::uint64_t segmentLow, const std::uint8_t* bits, std::size_t bytes)>& visit)
+	{
+		if (lo >= hi)
+			return;
+
+		const std::uint64_t firstByte{ lo / wheelSize };
+		const std::uint64_t lastByte{ (hi + wheelSize - 1) / wheelSize }; // one past the end
+		const std::uint64_t totalBytes{ lastByte - firstByte };
+		const std::size_t segments{ static_cast<std::size_t>((totalBytes + rangeSegmentBytes - 1) / rangeSegmentBytes) };
+
+		const std::vector<std::uint32_t> sievingPrimes{ smallPrimes(static_cast<std::uint32_t>(integerSqrt(lastByte * wheelSize) + 1)) };
+
+		// Every thread sieves into its own buffer.
+		std::vector<std::vector<std::uint8_t>> buffers(static_cast<std::size_t>(std::max(threadCount, 1)));
+
+		Parallel::forEachIndex(segments, threadCount, [&](std::size_t segment, int threadIndex) {
+			std::vector<std::uint8_t>& buffer{ buffers[threadIndex] };
+			buffer.resize(rangeSegmentBytes);
+
+			const std::uint64_t startByte{ firstByte + segment * rangeSegmentBytes };
+			const auto bytes{ static_cast<std::size_t>(std::min<std::uint64_t>(rangeSegmentBytes, lastByte - startByte)) };
+			sieveSegment(startByte * wheelSize, bytes, sievingPrimes, buffer.data());
+			visit(startByte * wheelSize, buffer.data(), bytes);
+		});
+	}
+
+	std::uint64_t countPrimes(std::uint64_t lo, std::uint64_t hi, int threadCount)
+	{
+		std::uint64_t count{ 0 };
+		for (const std::uint64_t p : { 2, 3, 5 })
+		{
+			if (p >= lo && p < hi)
+				++count;
+		}
+
+		std::atomic<std::uint64_t> segmentTotal{ 0 };
+		forEachSegment(lo, hi, threadCount, [&](std::uint64_t segmentLow, const std::uint8_t* bits, std::size_t bytes) {
+			std::uint64_t segmentCount{ 0 };
+			const std::uint64_t segmentHigh{ segmentLow + static_cast<std::uint64_t>(bytes) * wheelSize };
+
+			if (segmentLow >= lo && segmentHigh <= hi)
+			{
+				// Whole segment is in range, so just count the set bits 8 bytes at a time.
+				std::size_t i{ 0 };
+				for (; i + sizeof(std::uint64_t) <= bytes; i += sizeof(std::uint64_t))
+				{
+					std::uint64_t word{};
+					std::copy(bits + i, bits + i + sizeof(word), reinterpret_cast<std::uint8_t*>(&word));
+					segmentCount += std::popcount(word);
+				}
+				for (; i < bytes; ++i)
+					segmentCount += std::popcount(static_cast<unsigned int>(bits[i]));
+			}
+			else
+			{
+				// Edge segment, check each prime against the range.
+				for (std::size_t i{ 0 }; i < bytes; ++i)
+				{
+					for (int bit{ 0 }; bit < 8; ++bit)
+					{
+						const std::uint64_t n{ segmentLow + i * wheelSize + wheelResidues[bit] };
+						if ((bits[i] >> bit & 1) && n >= lo && n < hi)
+							++segmentCount;
+					}
+				}
+			}
+
+			segmentTotal.fetch_add(segmentCount, std::memory_order_relaxed);
+		});
+
+		return count + segmentTotal.load();
+	}
+}
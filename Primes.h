@@ -0,0 +1,99 @@
+#ifndef PRIMES_H
+#define PRIMES_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Parallel.h"
+
+// Faster prime testing for when isPrime() (8.x Q2) gets called millions of times.
+// Sieve builds a bitmap of every prime up to a bound once, after that each isPrime() is a single bit lookup.
+// Numbers above the bound are tested with Miller-Rabin, which is exact for every 64 bit number.
+namespace Primes
+{
+	// The bitmap only stores numbers that aren't multiples of 2, 3 or 5 (a "mod 30 wheel").
+	// Out of every 30 numbers only 8 can be prime: 30k + {1, 7, 11, 13, 17, 19, 23, 29}.
+	// So one byte covers 30 numbers, one bit per possible prime.
+	inline constexpr int wheelSize = 30;
+	inline constexpr int wheelResidues[8]{ 1, 7, 11, 13, 17, 19, 23, 29 };
+
+	// Sieving is done in segments this many bytes long, small enough to stay in the L1/L2 cache.
+	inline constexpr std::size_t segmentBytes = 32 * 1024;
+
+	// Returns all of the primes <= limit with a plain(non-segmented) sieve. Used to get the sieving primes.
+	std::vector<std::uint32_t> smallPrimes(std::uint32_t limit);
+
+	// Sieves the numbers [low, low + 30 * bytes) into out, using the wheel layout above.
+	// low must be a multiple of 30, sievingPrimes must hold every prime up to sqrt(low + 30 * bytes).
+	// A set bit means prime, except that 2, 3 and 5 are never stored.
+	void sieveSegment(std::uint64_t low, std::size_t bytes, const std::vector<std::uint32_t>& sievingPrimes, std::uint8_t* out);
+
+	// Deterministic Miller-Rabin, correct for every 64 bit value.
+	bool millerRabin(std::uint64_t n);
+
+	class Sieve
+	{
+	private:
+		std::uint64_t m_limit{};
+		std::vector<std::uint8_t> m_bits{};
+
+	public:
+		// Finds every prime up to and including limit. Takes limit / 30 bytes of memory.
+		explicit Sieve(std::uint64_t limit);
+
+		// Bitmap lookup for n <= limit(), Miller-Rabin above that.
+		bool isPrime(std::uint64_t n) const;
+
+		std::uint64_t limit() const { return m_limit; }
+	};
+
+	// isPrime backed by a shared Sieve up to defaultLimit. The sieve is built on the first call.
+	inline constexpr std::uint64_t defaultLimit = 1 << 24;
+	bool isPrime(std::uint64_t n);
+
+	// Range queries. These don't keep a bitmap around, they sieve [lo, hi) a segment at a time and throw each
+	// segment away once it's been looked at, so they only need memory for sqrt(hi) worth of sieving primes.
+	// Segments are rangeSegmentBytes long(about 3.9 million numbers, sized for L2) and get spread across threads.
+	inline constexpr std::size_t rangeSegmentBytes = 128 * 1024;
+
+	// Sieves the segments covering [lo, hi) on threadCount threads and calls visit(segmentLow, bits, bytes) for each one.
+	// bits uses the same wheel layout as sieveSegment(). The first and last segment can hold numbers outside [lo, hi).
+	// visit is called from several threads at once when threadCount > 1.
+	void forEachSegment(std::uint64_t lo, std::uint64_t hi, int threadCount,
+		const std::function<void(std::uint64_t segmentLow, const std::uint8_t* bits, std::size_t bytes)>& visit);
+
+	// Number of primes p with lo <= p < hi.
+	std::uint64_t countPrimes(std::uint64_t lo, std::uint64_t hi, int threadCount = Parallel::defaultThreadCount());
+
+	// Calls fn(p) for every prime p with lo <= p < hi.
+	// With one thread the primes come in increasing order. With more threads segments are handled in parallel,
+	// so fn must be safe to call from several threads and primes can arrive in any order.
+	template <typename Fn>
+	void forEachPrime(std::uint64_t lo, std::uint64_t hi, Fn&& fn, int threadCount = 1)
+	{
+		for (const std::uint64_t p : { 2, 3, 5 })
+		{
+			if (p >= lo && p < hi)
+				fn(p);
+		}
+
+		forEachSegment(lo, hi, threadCount, [&](std::uint64_t segmentLow, const std::uint8_t* bits, std::size_t bytes) {
+			for (std::size_t i{ 0 }; i < bytes; ++i)
+			{
+				unsigned int byte{ bits[i] };
+				while (byte != 0)
+				{
+					const std::uint64_t n{ segmentLow + i * wheelSize + wheelResidues[std::countr_zero(byte)] };
+					byte &= byte - 1; // clear the lowest set bit
+					if (n >= lo && n < hi)
+						fn(n);
+				}
+			}
+		});
+	}
+}
+
+#endif
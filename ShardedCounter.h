@@ -0,0 +1,95 @@
+#ifndef SHARDEDCOUNTER_H
+#define SHARDEDCOUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+// incrementAndPrint() and accumulate() keep their running total in a static local, which is fine for one thread
+// but is a data race as soon as two threads call them at once.
+// A single std::atomic<int> fixes the race, but then every thread fights over the same cache line.
+// ShardedCounter gives every thread its own slot (one cache line each) and only adds them up when get() is called.
+// Writes are cheap and never contend(as long as there are enough shards), reads cost one load per shard.
+namespace Sharded
+{
+	// Most desktop CPUs use 64 byte cache lines. We don't use std::hardware_destructive_interference_size
+	// because its value isn't stable between compiler versions.
+	inline constexpr std::size_t cacheLineSize = 64;
+
+	// Gives every thread a small id the first time it touches a counter. Ids are handed out round robin,
+	// so threads spread evenly over the shards.
+	inline std::size_t threadIndex()
+	{
+		static std::atomic<std::size_t> s_nextIndex{ 0 };
+		thread_local const std::size_t index{ s_nextIndex.fetch_add(1, std::memory_order_relaxed) };
+		return index;
+	}
+
+	// Rounds the number of hardware threads up to a power of two so picking a shard is a mask instead of a %.
+	inline std::size_t defaultShardCount()
+	{
+		std::size_t threads{ std::thread::hardware_concurrency() };
+		std::size_t shards{ 1 };
+		while (shards < threads)
+			shards *= 2;
+		return shards;
+	}
+}
+
+template <typename T>
+class ShardedCounter
+{
+private:
+	// alignas pads each slot out to a full cache line so two threads never share one.
+	struct alignas(Sharded::cacheLineSize) Slot
+	{
+		std::atomic<T> value{};
+	};
+
+	std::size_t m_mask{};
+	std::unique_ptr<Slot[]> m_slots{};
+
+public:
+	// shardCount is rounded up to a power of two.
+	explicit ShardedCounter(std::size_t shardCount = Sharded::defaultShardCount())
+	{
+		std::size_t shards{ 1 };
+		while (shards < shardCount)
+			shards *= 2;
+
+		m_mask = shards - 1;
+		m_slots = std::make_unique<Slot[]>(shards);
+	}
+
+	ShardedCounter(const ShardedCounter&) = delete;
+	ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+	// Relaxed is enough here, we only need each add to happen once, not in any particular order.
+	void add(T value)
+	{
+		m_slots[Sharded::threadIndex() & m_mask].value.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	void increment() { add(T{ 1 }); }
+
+	// Sums all the shards. If other threads are still adding, the result is somewhere between the
+	// totals before and after their adds(same guarantee as reading a single relaxed atomic).
+	T get() const
+	{
+		T total{};
+		for (std::size_t i{ 0 }; i <= m_mask; ++i)
+			total += m_slots[i].value.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	void reset()
+	{
+		for (std::size_t i{ 0 }; i <= m_mask; ++i)
+			m_slots[i].value.store(T{}, std::memory_order_relaxed);
+	}
+
+	std::size_t shardCount() const { return m_mask + 1; }
+};
+
+#endif
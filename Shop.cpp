@@ -0,0 +1,89 @@
+#include <algorithm>
+
+#include "Shop.h"
+
+namespace {
+	constexpr std::uint64_t goldMask{ (std::uint64_t{ 1 } << Shop::goldBits) - 1 };
+	constexpr std::uint64_t countMask{ (std::uint64_t{ 1 } << Shop::countBits) - 1 };
+
+	constexpr int countShift(int potion) {
+		return Shop::goldBits + potion * Shop::countBits;
+	}
+
+	static_assert(Shop::goldBits + Potion::max_types * Shop::countBits <= 64, "player state doesn't fit in 64 bits");
+}
+
+std::uint64_t Shop::pack(const PlayerState& state) {
+	std::uint64_t word{ static_cast<std::uint64_t>(std::clamp<std::int64_t>(state.gold, 0, maxGold)) };
+	for (int potion{ 0 }; potion < Potion::max_types; ++potion)
+		word |= static_cast<std::uint64_t>(std::clamp(state.inventory[potion], 0, maxCount)) << countShift(potion);
+	return word;
+}
+
+Shop::PlayerState Shop::unpack(std::uint64_t word) {
+	PlayerState state{};
+	state.gold = static_cast<int>(word & goldMask);
+	for (int potion{ 0 }; potion < Potion::max_types; ++potion)
+		state.inventory[potion] = static_cast<int>((word >> countShift(potion)) & countMask);
+	return state;
+}
+
+Shop::Shop(std::size_t playerCount, int startingGold, const std::array<int, Potion::max_types>& costs)
+	: m_playerCount{ playerCount }, m_players{ std::make_unique<std::atomic<std::uint64_t>[]>(playerCount) }, m_prices{ costs }
+{
+	const std::uint64_t start{ pack(PlayerState{ startingGold, {} }) };
+	for (std::size_t i{ 0 }; i < playerCount; ++i)
+		m_players[i].store(start, std::memory_order_relaxed);
+}
+
+Shop::Outcome Shop::buy(std::uint32_t player, Potion::Type potion) {
+	if (player >= m_playerCount)
+		return Outcome::noSuchPlayer;
+
+	const auto cost{ static_cast<std::uint64_t>(m_prices.price(potion)) };
+	const int shift{ countShift(potion) };
+	std::atomic<std::uint64_t>& slot{ m_players[player] };
+
+	std::uint64_t word{ slot.load(std::memory_order_relaxed) };
+	while (true) {
+		if ((word & goldMask) < cost)
+			return Outcome::notEnoughGold;
+		if (((word >> shift) & countMask) == countMask)
+			return Outcome::inventoryFull;
+
+		// Gold and count are separate bit fields and neither can wrap(checked above), so plain arithmetic works.
+		const std::uint64_t updated{ word - cost + (std::uint64_t{ 1 } << shift) };
+		// On failure compare_exchange_weak loads the current value into word and we check again.
+		if (slot.compare_exchange_weak(word, updated, std::memory_order_acq_rel, std::memory_order_relaxed))
+			return Outcome::bought;
+	}
+}
+
+std::size_t Shop::processBatch(std::span<const Request> requests, std::span<Outcome> outcomes) {
+	std::size_t bought{ 0 };
+	for (std::size_t i{ 0 }; i < requests.size(); ++i) {
+		outcomes[i] = buy(requests[i].player, requests[i].potion);
+		bought += outcomes[i] == Outcome::bought;
+	}
+	return bought;
+}
+
+std::size_t Shop::processAll(std::span<const Request> requests, std::span<Outcome> outcomes, int threadCount, std::size_t batchSize) {
+	if (batchSize == 0)
+		batchSize = 1;
+
+	std::atomic<std::size_t> bought{ 0 };
+	const std::size_t batches{ (requests.size() + batchSize - 1) / batchSize };
+	Parallel::forEachIndex(batches, threadCount, [&](std::size_t batch, int) {
+		const std::size_t start{ batch * batchSize };
+		const std::size_t count{ std::min(batchSize, requests.size() - start) };
+		bought.fetch_add(processBatch(requests.subspan(start, count), outcomes.subspan(start, count)), std::memory_order_relaxed);
+	});
+	return bought.load();
+}
+
+Shop::PlayerState Shop::state(std::uint32_t player) const {
+	if (player >= m_playerCount)
+		return PlayerState{}; //same check as buy()
+	return unpack(m_players[player].load(std::memory_order_acquire));
+}
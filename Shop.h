@@ -0,0 +1,84 @@
+#ifndef SHOP_H
+#define SHOP_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "Parallel.h"
+#include "Potion.h"
+#include "PriceTable.h"
+
+// Server side version of the 17.x potion shop: many players buying at once from many threads.
+// A purchase has to take the gold and add the potion together, nobody should ever see one without the other.
+//
+// Each player's whole state(gold and a count for every potion) is packed into one 64 bit word, so a purchase is a
+// single compare-and-swap: read the word, check the player can afford it, write back the word with less gold and
+// one more potion. If another thread changed the word in between, the CAS fails and we try again with the new value.
+// No locks, and two threads only ever wait on each other when they are buying for the same player.
+//
+// Requests are handled in batches(processBatch), so a worker thread deals with a few hundred purchases per call
+// instead of going through a queue for every single one.
+class Shop {
+public:
+	// Bit layout of a player's word: gold in the low goldBits, then countBits per potion type.
+	static constexpr int goldBits{ 24 };
+	static constexpr int countBits{ (64 - goldBits) / Potion::max_types };
+	static constexpr std::int64_t maxGold{ (std::int64_t{ 1 } << goldBits) - 1 };
+	static constexpr int maxCount{ (1 << countBits) - 1 };
+
+	enum class Outcome : std::uint8_t {
+		bought,
+		notEnoughGold,
+		inventoryFull, // the player already has maxCount of that potion
+		noSuchPlayer,
+	};
+
+	struct Request {
+		std::uint32_t player{};
+		Potion::Type potion{};
+	};
+
+	struct PlayerState {
+		int gold{};
+		std::array<int, Potion::max_types> inventory{};
+	};
+
+private:
+	std::size_t m_playerCount{};
+	std::unique_ptr<std::atomic<std::uint64_t>[]> m_players{};
+	PriceTable m_prices;
+
+	static std::uint64_t pack(const PlayerState& state);
+	static PlayerState unpack(std::uint64_t word);
+
+public:
+	// Every player starts with startingGold(clamped to maxGold) and no potions.
+	Shop(std::size_t playerCount, int startingGold, const std::array<int, Potion::max_types>& costs = Potion::costs);
+
+	std::size_t playerCount() const { return m_playerCount; }
+
+	// Prices can be changed while purchases are going on. A purchase pays whatever the price was when it started.
+	PriceTable& prices() { return m_prices; }
+	const PriceTable& prices() const { return m_prices; }
+
+	// Thread safe. Either takes the gold and adds the potion, or changes nothing.
+	Outcome buy(std::uint32_t player, Potion::Type potion);
+
+	// Thread safe. outcomes must be at least as long as requests, outcomes[i] is what happened to requests[i].
+	// Returns how many purchases went through.
+	std::size_t processBatch(std::span<const Request> requests, std::span<Outcome> outcomes);
+
+	// Splits requests into batches of batchSize and processes them on threadCount threads.
+	std::size_t processAll(std::span<const Request> requests, std::span<Outcome> outcomes,
+		int threadCount = Parallel::defaultThreadCount(), std::size_t batchSize = 256);
+
+	// A consistent snapshot of one player(gold and potions from the same moment).
+	// No gold and no potions for a player that doesn't exist.
+	PlayerState state(std::uint32_t player) const;
+};
+
+#endif
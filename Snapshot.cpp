@@ -0,0 +1,11 @@
+#include "Snapshot.h"
+
+GameState GameState::capture(const Player& player, std::span<const Monster> monsters)
+{
+	GameState state{};
+	state.player.gold = player.getGold();
+	for (const Potion::Type type : Potion::types)
+		state.player.inventory[type] = player.inventory(type);
+	state.monsters = CowVector<Monster>{ monsters };
+	return state;
+}
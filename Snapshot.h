@@ -0,0 +1,124 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Monster.h"
+#include "Player.h"
+#include "Potion.h"
+
+// A vector that can be forked in O(1). Forks share their elements until one of them writes, then only the chunk
+// being written to is copied(plus the small table of chunk pointers, once per fork).
+// So 10K forks of 100K monsters that each change a few monsters cost a few chunks each, not 10K full copies.
+//
+// Elements are split into chunks of ChunkSize(4KB worth by default). A fork is just another shared_ptr to the
+// same chunk table. Before a write we check whether we are the only owner of the table and of the chunk,
+// and copy whichever one we share.
+//
+// Thread safety: different forks can be read and written from different threads at the same time. A single
+// CowVector object(one fork) must not be written from two threads at once, same as std::vector.
+template <typename T, std::size_t ChunkSize = (4096 / sizeof(T) > 0 ? 4096 / sizeof(T) : 1)>
+class CowVector
+{
+private:
+	// A vector rather than std::array so T doesn't need a default constructor(Monster doesn't have one).
+	using Chunk = std::vector<T>;
+
+	struct Table
+	{
+		std::vector<std::shared_ptr<Chunk>> chunks{};
+		std::size_t size{};
+	};
+
+	std::shared_ptr<Table> m_table{ std::make_shared<Table>() };
+
+	// use_count() == 1 means nobody else can be holding a reference to p, so nobody can start sharing it either.
+	// The fence pairs with the release in the other owners' shared_ptr destructors, so their last reads of the
+	// object have finished before we start writing to it.
+	template <typename U>
+	static bool isUnique(const std::shared_ptr<U>& p)
+	{
+		if (p.use_count() != 1)
+			return false;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return true;
+	}
+
+public:
+	CowVector() = default;
+
+	explicit CowVector(std::span<const T> items)
+	{
+		m_table->size = items.size();
+		m_table->chunks.reserve((items.size() + ChunkSize - 1) / ChunkSize);
+		for (std::size_t start{ 0 }; start < items.size(); start += ChunkSize)
+		{
+			const std::size_t end{ start + ChunkSize < items.size() ? start + ChunkSize : items.size() };
+			m_table->chunks.push_back(std::make_shared<Chunk>(items.begin() + start, items.begin() + end));
+		}
+	}
+
+	// Copying is forking: O(1), nothing but a reference count goes up.
+	CowVector fork() const { return *this; }
+
+	std::size_t size() const { return m_table->size; }
+
+	const T& operator[](std::size_t index) const { return (*m_table->chunks[index / ChunkSize])[index % ChunkSize]; }
+
+	// Returns a reference that is safe to write through, copying the table and/or chunk first if they are shared.
+	// The reference is invalidated by fork()ing this vector and then writing to either copy.
+	T& mutate(std::size_t index)
+	{
+		if (!isUnique(m_table))
+			m_table = std::make_shared<Table>(*m_table);
+
+		std::shared_ptr<Chunk>& chunk{ m_table->chunks[index / ChunkSize] };
+		if (!isUnique(chunk))
+			chunk = std::make_shared<Chunk>(*chunk);
+		return (*chunk)[index % ChunkSize];
+	}
+
+	// Bytes of memory only this fork is holding on to: its own table and the chunks it has copied.
+	std::size_t ownedBytes() const
+	{
+		std::size_t bytes{ 0 };
+		if (m_table.use_count() == 1)
+			bytes += sizeof(Table) + m_table->chunks.capacity() * sizeof(std::shared_ptr<Chunk>);
+		for (const auto& chunk : m_table->chunks)
+		{
+			if (chunk.use_count() == 1)
+				bytes += sizeof(Chunk) + chunk->capacity() * sizeof(T);
+		}
+		return bytes;
+	}
+
+	static constexpr std::size_t chunkSize() { return ChunkSize; }
+};
+
+// The part of the game balance tuning wants to fork: a player's gold and potions, and the monsters still around.
+// The player part is a few bytes so it is just copied, the monsters go in a CowVector.
+struct GameState
+{
+	struct PlayerState
+	{
+		int gold{};
+		std::array<int, Potion::max_types> inventory{};
+	};
+
+	PlayerState player{};
+	CowVector<Monster> monsters{};
+
+	static GameState capture(const Player& player, std::span<const Monster> monsters);
+
+	GameState fork() const { return *this; }
+
+	// sizeof(GameState) plus whatever monster chunks this fork owns.
+	std::size_t ownedBytes() const { return sizeof(GameState) + monsters.ownedBytes(); }
+};
+
+#endif
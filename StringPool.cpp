@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "StringPool.h"
+
+namespace
+{
+	// FNV-1a, simple and good enough for short strings like names.
+	std::uint64_t hashString(std::string_view text)
+	{
+		std::uint64_t hash{ 14695981039346656037ull };
+		for (const char c : text)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	constexpr std::size_t textChunkSize = 64 * 1024;
+	constexpr std::size_t initialTableSize = 1024;
+}
+
+std::string_view StringPool::Handle::view() const
+{
+	return StringPool::global().get(*this);
+}
+
+StringPool::Table::Table(std::size_t capacity)
+	: mask{ capacity - 1 }, slots{ std::make_unique<std::atomic<std::uint32_t>[]>(capacity) }
+{ }
+
+StringPool::StringPool()
+{
+	m_tables.push_back(std::make_unique<Table>(initialTableSize));
+	m_table.store(m_tables.back().get(), std::memory_order_release);
+
+	// id 0 is "", so a default constructed Handle can always be looked up.
+	intern("");
+}
+
+StringPool& StringPool::global()
+{
+	static StringPool s_pool{};
+	return s_pool;
+}
+
+const StringPool::Entry& StringPool::entry(std::uint32_t id) const
+{
+	const Entry* block{ m_entryBlocks[id >> entryBlockBits].load(std::memory_order_acquire) };
+	return block[id & (entryBlockSize - 1)];
+}
+
+std::uint32_t StringPool::findId(std::string_view text, std::uint64_t hash) const
+{
+	const Table* table{ m_table.load(std::memory_order_acquire) };
+	for (std::size_t slot{ hash & table->mask };; slot = (slot + 1) & table->mask)
+	{
+		const std::uint32_t value{ table->slots[slot].load(std::memory_order_acquire) };
+		if (value == 0)
+			return 0;
+
+		// Compare the stored hash first, so most mismatches never touch the text.
+		const Entry& e{ entry(value - 1) };
+		if (e.hash == hash && std::string_view{ e.data, e.length } == text)
+			return value;
+	}
+}
+
+bool StringPool::find(std::string_view text, Handle& handle) const
+{
+	const std::uint32_t value{ findId(text, hashString(text)) };
+	if (value == 0)
+		return false;
+	handle = Handle{ value - 1 };
+	return true;
+}
+
+const char* StringPool::storeText(std::string_view text)
+{
+	// Big strings get a chunk of their own so they don't waste the rest of a shared one.
+	if (text.size() > textChunkSize / 4)
+	{
+		m_textChunks.push_back(std::make_unique<char[]>(text.size()));
+		std::memcpy(m_textChunks.back().get(), text.data(), text.size());
+		return m_textChunks.back().get();
+	}
+
+	if (m_textCurrent == nullptr || textChunkSize - m_textUsed < text.size())
+	{
+		m_textChunks.push_back(std::make_unique<char[]>(textChunkSize));
+		m_textCurrent = m_textChunks.back().get();
+		m_textUsed = 0;
+	}
+
+	char* dest{ m_textCurrent + m_textUsed };
+	std::memcpy(dest, text.data(), text.size());
+	m_textUsed += text.size();
+	return dest;
+}
+
+void StringPool::insertIntoTable(Table& table, std::uint32_t id, std::uint64_t hash)
+{
+	std::size_t slot{ hash & table.mask };
+	while (table.slots[slot].load(std::memory_order_relaxed) != 0)
+		slot = (slot + 1) & table.mask;
+	// Release, so a reader that sees this slot also sees the finished entry.
+	table.slots[slot].store(id + 1, std::memory_order_release);
+}
+
+StringPool::Handle StringPool::intern(std::string_view text)
+{
+	const std::uint64_t hash{ hashString(text) };
+
+	// Fast path, no lock.
+	if (const std::uint32_t value{ findId(text, hash) }; value != 0)
+		return Handle{ value - 1 };
+
+	std::lock_guard lock{ m_insertMutex };
+
+	// Someone else may have added it while we waited for the lock.
+	if (const std::uint32_t value{ findId(text, hash) }; value != 0)
+		return Handle{ value - 1 };
+
+	const std::uint32_t id{ m_size.load(std::memory_order_relaxed) };
+	const std::size_t blockIndex{ id >> entryBlockBits };
+	assert(blockIndex < maxEntryBlocks && "StringPool is full");
+
+	if (m_entryBlocks[blockIndex].load(std::memory_order_relaxed) == nullptr)
+	{
+		m_ownedBlocks.push_back(std::make_unique<Entry[]>(entryBlockSize));
+		m_entryBlocks[blockIndex].store(m_ownedBlocks.back().get(), std::memory_order_release);
+	}
+
+	Entry& e{ m_ownedBlocks[blockIndex][id & (entryBlockSize - 1)] };
+	e.data = storeText(text);
+	e.length = static_cast<std::uint32_t>(text.size());
+	e.hash = hash;
+	m_size.store(id + 1, std::memory_order_release);
+
+	// Keep the table at most half full. Readers keep using the old table until the new one is published.
+	Table* table{ m_table.load(std::memory_order_relaxed) };
+	if ((static_cast<std::size_t>(id) + 1) * 2 > table->mask + 1)
+	{
+		auto bigger{ std::make_unique<Table>((table->mask + 1) * 2) };
+		for (std::uint32_t i{ 0 }; i < id; ++i)
+			insertIntoTable(*bigger, i, entry(i).hash);
+		table = bigger.get();
+		m_tables.push_back(std::move(bigger));
+		insertIntoTable(*table, id, hash);
+		m_table.store(table, std::memory_order_release);
+	}
+	else
+	{
+		insertIntoTable(*table, id, hash);
+	}
+
+	return Handle{ id };
+}
@@ -0,0 +1,105 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// Interns strings: every distinct string is stored once, and callers hold a 4 byte Handle to it.
+// MonsterGenerator hands out the same handful of names and roars over and over, so instead of building a new
+// std::string for every monster they all share one copy.
+// Strings are never removed or moved once added, so a string_view from get() stays valid as long as the pool does.
+// The empty string is always there as id 0, so a default Handle{} reads as "".
+//
+// Thread safety: get() and find() never take a lock, they only do atomic loads. intern() also finds existing
+// strings without a lock, and only locks a mutex when it has to add a new string.
+class StringPool
+{
+public:
+	class Handle
+	{
+	private:
+		std::uint32_t m_id{ 0 };
+
+	public:
+		// The empty string, which every pool has.
+		constexpr Handle() = default;
+		constexpr explicit Handle(std::uint32_t id) : m_id{ id } {}
+
+		constexpr std::uint32_t id() const { return m_id; }
+
+		// The string in the global pool. Only use on handles that came from StringPool::global().
+		std::string_view view() const;
+
+		friend constexpr bool operator==(Handle a, Handle b) { return a.m_id == b.m_id; }
+	};
+
+private:
+	struct Entry
+	{
+		const char* data{};
+		std::uint32_t length{};
+		std::uint64_t hash{};
+	};
+
+	// Entries live in fixed size blocks that are never moved, found through a fixed size array of block pointers.
+	static constexpr std::size_t entryBlockBits = 12;
+	static constexpr std::size_t entryBlockSize = std::size_t{ 1 } << entryBlockBits;
+	static constexpr std::size_t maxEntryBlocks = 4096; // up to 16M strings
+
+	// Open addressing hash table of entry ids. A slot holds id + 1, so 0 means empty.
+	struct Table
+	{
+		std::size_t mask{};
+		std::unique_ptr<std::atomic<std::uint32_t>[]> slots{};
+		explicit Table(std::size_t capacity);
+	};
+
+	std::array<std::atomic<Entry*>, maxEntryBlocks> m_entryBlocks{};
+	std::atomic<std::uint32_t> m_size{ 0 };
+	std::atomic<Table*> m_table{};
+
+	// Everything below is only touched while holding m_insertMutex.
+	std::mutex m_insertMutex{};
+	std::vector<std::unique_ptr<Entry[]>> m_ownedBlocks{};
+	std::vector<std::unique_ptr<char[]>> m_textChunks{};
+	char* m_textCurrent{}; // chunk that small strings are being packed into
+	std::size_t m_textUsed{ 0 };
+	// Old tables are kept until the pool is destroyed, a reader might still be probing one.
+	std::vector<std::unique_ptr<Table>> m_tables{};
+
+	const Entry& entry(std::uint32_t id) const;
+	std::uint32_t findId(std::string_view text, std::uint64_t hash) const; // returns id + 1, or 0
+	const char* storeText(std::string_view text);
+	void insertIntoTable(Table& table, std::uint32_t id, std::uint64_t hash);
+
+public:
+	StringPool();
+	StringPool(const StringPool&) = delete;
+	StringPool& operator=(const StringPool&) = delete;
+
+	// The pool used for monster names and roars.
+	static StringPool& global();
+
+	// Returns the handle for text, adding it if it isn't in the pool yet.
+	Handle intern(std::string_view text);
+
+	// Returns true and sets handle if text is in the pool. Never adds anything.
+	bool find(std::string_view text, Handle& handle) const;
+
+	std::string_view get(Handle handle) const
+	{
+		const Entry& e{ entry(handle.id()) };
+		return { e.data, e.length };
+	}
+
+	// Distinct strings in the pool, counting the empty one.
+	std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+};
+
+#endif
@@ -0,0 +1,230 @@
+#include <cstdint>
+#include <limits>
+
+#include "Sums.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	// Signed 128 bit integer, just enough of one for the formulas below. MSVC has no 128 bit type, so this is
+	// two halves, filled in the same ways as mulMod() in Primes.cpp.
+	struct Int128
+	{
+		std::uint64_t low{};
+		std::int64_t high{}; // -1 for negative numbers that fit in 64 bits
+
+		static Int128 from(long long value) { return Int128{ static_cast<std::uint64_t>(value), value < 0 ? -1 : 0 }; }
+
+		std::optional<long long> toLongLong() const
+		{
+			const auto value{ static_cast<long long>(low) };
+			if (high != (value < 0 ? -1 : 0))
+				return std::nullopt;
+			return value;
+		}
+	};
+
+	Int128 add(Int128 a, Int128 b)
+	{
+		const std::uint64_t low{ a.low + b.low };
+		const std::uint64_t carry{ low < a.low ? 1u : 0u };
+		return Int128{ low, static_cast<std::int64_t>(static_cast<std::uint64_t>(a.high) + static_cast<std::uint64_t>(b.high) + carry) };
+	}
+
+	// Divides an even number by 2.
+	Int128 half(Int128 a)
+	{
+		return Int128{ (a.low >> 1) | (static_cast<std::uint64_t>(a.high) << 63), a.high >> 1 };
+	}
+
+	// a * b, which always fits in 128 bits.
+	Int128 multiply(long long a, long long b)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		long long high{};
+		const long long low{ _mul128(a, b, &high) };
+		return Int128{ static_cast<std::uint64_t>(low), high };
+#elif defined(__SIZEOF_INT128__)
+		const __int128 product{ static_cast<__int128>(a) * b };
+		return Int128{ static_cast<std::uint64_t>(product), static_cast<std::int64_t>(product >> 64) };
+#else
+		// Multiply the sizes in 32 bit pieces, then fix up the sign.
+		const std::uint64_t x{ a < 0 ? 0 - static_cast<std::uint64_t>(a) : static_cast<std::uint64_t>(a) };
+		const std::uint64_t y{ b < 0 ? 0 - static_cast<std::uint64_t>(b) : static_cast<std::uint64_t>(b) };
+		const std::uint64_t lowLow{ (x & 0xFFFFFFFF) * (y & 0xFFFFFFFF) };
+		const std::uint64_t highLow{ (x >> 32) * (y & 0xFFFFFFFF) };
+		const std::uint64_t lowHigh{ (x & 0xFFFFFFFF) * (y >> 32) };
+		const std::uint64_t middle{ (lowLow >> 32) + (highLow & 0xFFFFFFFF) + (lowHigh & 0xFFFFFFFF) };
+		Int128 product{ (middle << 32) | (lowLow & 0xFFFFFFFF),
+			static_cast<std::int64_t>((x >> 32) * (y >> 32) + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32)) };
+		if ((a < 0) != (b < 0))
+			product = add(Int128{ ~product.low, ~product.high }, Int128::from(1));
+		return product;
+#endif
+	}
+
+	std::optional<long long> checkedMultiply(long long a, long long b)
+	{
+		return multiply(a, b).toLongLong();
+	}
+
+	std::optional<long long> checkedAdd(long long a, long long b)
+	{
+		return add(Int128::from(a), Int128::from(b)).toLongLong();
+	}
+
+	// 0^2 + 1^2 + ... + n^2 = n(n + 1)(2n + 1) / 6, for n >= 0.
+	std::optional<long long> sumOfSquaresTo(long long n)
+	{
+		const std::optional<long long> next{ checkedAdd(n, 1) };
+		const std::optional<long long> twiceNext{ next ? checkedAdd(n, *next) : std::nullopt };
+		if (!twiceNext)
+			return std::nullopt; // the answer is bigger than n^2 anyway
+
+		long long a{ n };
+		long long b{ *next };
+		long long c{ *twiceNext };
+		// One of n and n + 1 is even, and one of the three is a multiple of 3.
+		if (a % 2 == 0)
+			a /= 2;
+		else
+			b /= 2;
+		if (a % 3 == 0)
+			a /= 3;
+		else if (b % 3 == 0)
+			b /= 3;
+		else
+			c /= 3;
+
+		const std::optional<long long> ab{ checkedMultiply(a, b) };
+		if (!ab)
+			return std::nullopt;
+		return checkedMultiply(*ab, c);
+	}
+
+	// lo^2 + ... + hi^2 for 0 <= lo <= hi. Split up as a sum over j = 0..m, m = hi - lo, of
+	// (lo + j)^2 = lo^2 + 2 lo j + j^2, which gives (m + 1) lo^2 + lo m(m + 1) + (0^2 + ... + m^2).
+	// None of the three parts is negative, so if one of them doesn't fit the answer doesn't either.
+	std::optional<long long> sumOfPositiveSquares(long long lo, long long hi)
+	{
+		const long long m{ hi - lo };
+		const std::optional<long long> count{ checkedAdd(m, 1) };
+		if (!count)
+			return std::nullopt;
+
+		const std::optional<long long> loSquared{ checkedMultiply(lo, lo) };
+		const std::optional<long long> mm1{ checkedMultiply(m, *count) };
+		const std::optional<long long> squares{ sumOfSquaresTo(m) };
+		if (!loSquared || !mm1 || !squares)
+			return std::nullopt;
+
+		const std::optional<long long> first{ checkedMultiply(*count, *loSquared) };
+		const std::optional<long long> second{ checkedMultiply(lo, *mm1) };
+		if (!first || !second)
+			return std::nullopt;
+		const std::optional<long long> firstTwo{ checkedAdd(*first, *second) };
+		if (!firstTwo)
+			return std::nullopt;
+		return checkedAdd(*firstTwo, *squares);
+	}
+}
+
+namespace Sums
+{
+	std::optional<long long> sumRange(long long lo, long long hi)
+	{
+		if (hi < lo)
+			return 0;
+
+		// hi - lo + 1 overflows for ranges like [LLONG_MIN, LLONG_MAX], even though the answer(-2^63) fits.
+		// When the range crosses 0, [-k, k] adds up to 0, so only the part sticking out past it is summed.
+		if (lo < 0 && hi > 0)
+		{
+			if (lo + hi < 0) // -lo > hi, without working out -lo(which overflows for LLONG_MIN)
+				return sumStrided(lo, 1, -(lo + hi)); // [lo, -hi - 1]
+			if (lo + hi == 0)
+				return 0;
+			return sumStrided(-lo + 1, 1, lo + hi); // [-lo + 1, hi]
+		}
+
+		const std::optional<long long> count{ add(add(Int128::from(hi), multiply(lo, -1)), Int128::from(1)).toLongLong() };
+		if (!count)
+			return std::nullopt; // 2^63 values on one side of 0
+		return sumStrided(lo, 1, *count);
+	}
+
+	std::optional<long long> sumStrided(long long first, long long step, long long count)
+	{
+		if (count <= 0)
+			return 0;
+
+		// count terms, averaging (first + last) / 2. Either count or first + last is even.
+		// first + last = 2 first + (count - 1) step can be 128 bits long.
+		long long terms{ count };
+		Int128 ends{ add(multiply(first, 2), multiply(count - 1, step)) };
+		if (terms % 2 == 0)
+			terms /= 2;
+		else
+			ends = half(ends);
+
+		// terms is at least 1, so if ends doesn't fit in 64 bits neither does the answer.
+		const std::optional<long long> average{ ends.toLongLong() };
+		if (!average)
+			return std::nullopt;
+		return checkedMultiply(terms, *average);
+	}
+
+	std::optional<long long> sumOfSquares(long long lo, long long hi)
+	{
+		if (hi < lo)
+			return 0;
+		if (lo >= 0)
+			return sumOfPositiveSquares(lo, hi);
+		if (lo == std::numeric_limits<long long>::min())
+			return std::nullopt; // lo^2 alone is 2^126
+
+		// (-x)^2 = x^2, so flip the negative part over to the positive side.
+		if (hi <= 0)
+			return sumOfPositiveSquares(-hi, -lo);
+		const std::optional<long long> negative{ sumOfPositiveSquares(1, -lo) };
+		const std::optional<long long> positive{ sumOfPositiveSquares(0, hi) };
+		if (!negative || !positive)
+			return std::nullopt;
+		return checkedAdd(*negative, *positive);
+	}
+
+	long long sumSpan(std::span<const int> values, int threadCount)
+	{
+		// One piece per thread, but never more pieces than values.
+		const std::size_t pieces{ std::clamp<std::size_t>(threadCount < 1 ? 1 : threadCount, 1, values.empty() ? 1 : values.size()) };
+		std::vector<long long> partials(pieces);
+
+		Parallel::forEachIndex(pieces, threadCount, [&](std::size_t piece, int) {
+			const std::span<const int> slice{ values.subspan(values.size() * piece / pieces,
+				values.size() * (piece + 1) / pieces - values.size() * piece / pieces) };
+
+			// Four independent running totals, so each add doesn't have to wait on the one before it.
+			long long totals[4]{};
+			std::size_t i{ 0 };
+			for (; i + 4 <= slice.size(); i += 4)
+			{
+				totals[0] += slice[i];
+				totals[1] += slice[i + 1];
+				totals[2] += slice[i + 2];
+				totals[3] += slice[i + 3];
+			}
+			for (; i < slice.size(); ++i)
+				totals[0] += slice[i];
+
+			partials[piece] = totals[0] + totals[1] + totals[2] + totals[3];
+		});
+
+		long long total{ 0 };
+		for (const long long partial : partials)
+			total += partial;
+		return total;
+	}
+}
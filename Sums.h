@@ -0,0 +1,60 @@
+#ifndef SUMS_H
+#define SUMS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Parallel.h"
+
+// Replacements for sumTo() (8.10 Q2), which loops from 1 to x in an int and overflows once x is above ~65535.
+// The arithmetic series ones use closed forms, so they are O(1). The span and generator ones add up
+// values that don't have a formula, using several accumulators so the compiler can vectorize the loop,
+// and optionally several threads.
+namespace Sums
+{
+	// The closed form ones return std::nullopt if the answer doesn't fit in a long long. Products are worked out
+	// in 128 bits, so it's only the answer that has to fit, not the steps on the way there.
+
+	// lo + (lo + 1) + ... + hi. Returns 0 if hi < lo. Always fits for int arguments.
+	std::optional<long long> sumRange(long long lo, long long hi);
+
+	// first + (first + step) + ... for count terms. Returns 0 if count <= 0.
+	std::optional<long long> sumStrided(long long first, long long step, long long count);
+
+	// lo^2 + (lo + 1)^2 + ... + hi^2. Returns 0 if hi < lo.
+	std::optional<long long> sumOfSquares(long long lo, long long hi);
+
+	// Adds up every value in the span. Each thread takes an equal slice.
+	long long sumSpan(std::span<const int> values, int threadCount = 1);
+
+	// generate(0) + generate(1) + ... + generate(count - 1), for sequences with no closed form.
+	// generate is called from several threads when threadCount > 1.
+	template <typename Generate>
+	long long sumGenerated(long long count, Generate generate, int threadCount = 1)
+	{
+		if (count <= 0)
+			return 0;
+
+		const std::size_t pieces{ static_cast<std::size_t>(std::clamp<long long>(threadCount, 1, count)) };
+		std::vector<long long> partials(pieces);
+		Parallel::forEachIndex(pieces, threadCount, [&](std::size_t piece, int) {
+			const long long begin{ count * static_cast<long long>(piece) / static_cast<long long>(pieces) };
+			const long long end{ count * static_cast<long long>(piece + 1) / static_cast<long long>(pieces) };
+
+			long long total{ 0 };
+			for (long long i{ begin }; i < end; ++i)
+				total += generate(i);
+			partials[piece] = total;
+		});
+
+		long long total{ 0 };
+		for (const long long partial : partials)
+			total += partial;
+		return total;
+	}
+}
+
+#endif
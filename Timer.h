@@ -0,0 +1,30 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <chrono>
+
+// Small stopwatch used for timing code, based on the Timer class from learncpp.com
+// (https://www.learncpp.com/cpp-tutorial/timing-your-code/)
+// The timer starts when it is created, call reset() to start timing again.
+class Timer
+{
+private:
+	using Clock = std::chrono::steady_clock;
+	using Second = std::chrono::duration<double, std::ratio<1>>;
+
+	std::chrono::time_point<Clock> m_beg{ Clock::now() };
+
+public:
+	void reset()
+	{
+		m_beg = Clock::now();
+	}
+
+	// Returns the number of seconds since the timer was created or last reset.
+	double elapsed() const
+	{
+		return std::chrono::duration_cast<Second>(Clock::now() - m_beg).count();
+	}
+};
+
+#endif